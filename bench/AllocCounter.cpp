@@ -0,0 +1,35 @@
+#include "AllocCounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::size_t> g_allocBytes{0};
+std::atomic<std::size_t> g_allocCount{0};
+
+void* CountedAlloc(std::size_t size) {
+    g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size ? size : 1);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+} // namespace
+
+// nothrow new forwards to these; over-aligned allocations are not counted
+void* operator new(std::size_t size) { return CountedAlloc(size); }
+void* operator new[](std::size_t size) { return CountedAlloc(size); }
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace OreForged {
+namespace Bench {
+
+AllocStats GetAllocStats() {
+    return {g_allocBytes.load(std::memory_order_relaxed), g_allocCount.load(std::memory_order_relaxed)};
+}
+
+} // namespace Bench
+} // namespace OreForged
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <string>
+
+namespace OreForged {
+namespace Bench {
+
+// Totals from the replacement operator new in AllocCounter.cpp, across all
+// threads since the process started
+struct AllocStats {
+    std::size_t bytes;
+    std::size_t count;
+};
+
+AllocStats GetAllocStats();
+
+// Counts allocations made during a benchmark loop and reports them per unit
+// of work, e.g. per chunk. Pause/Resume alongside PauseTiming/ResumeTiming to
+// leave setup out.
+class AllocScope {
+public:
+    AllocScope() : m_start(GetAllocStats()) {}
+
+    void Pause() { m_pausedAt = GetAllocStats(); }
+    void Resume() {
+        AllocStats now = GetAllocStats();
+        m_excluded.bytes += now.bytes - m_pausedAt.bytes;
+        m_excluded.count += now.count - m_pausedAt.count;
+    }
+
+    void Report(benchmark::State& state, double units, const std::string& unit) const {
+        if (units <= 0) return;
+        AllocStats end = GetAllocStats();
+        state.counters["bytes_alloc/" + unit] = (end.bytes - m_start.bytes - m_excluded.bytes) / units;
+        state.counters["allocs/" + unit] = (end.count - m_start.count - m_excluded.count) / units;
+    }
+
+private:
+    AllocStats m_start;
+    AllocStats m_pausedAt{0, 0};
+    AllocStats m_excluded{0, 0};
+};
+
+} // namespace Bench
+} // namespace OreForged
@@ -0,0 +1,19 @@
+#include <benchmark/benchmark.h>
+#include <iostream>
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    // World and Game log to std::cout; keep that out of the report. Use
+    // --benchmark_out=<file> for JSON/CSV output.
+    std::ostream reportOut(std::cout.rdbuf());
+    std::cout.rdbuf(nullptr);
+
+    benchmark::ConsoleReporter reporter;
+    reporter.SetOutputStream(&reportOut);
+    reporter.SetErrorStream(&std::cerr);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+    return 0;
+}
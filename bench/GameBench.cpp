@@ -0,0 +1,118 @@
+#include "AllocCounter.h"
+#include "Game.h"
+#include "core/BindingArgs.h"
+#include <algorithm>
+#include <memory>
+#include <nlohmann/json.hpp>
+
+using OreForged::Bench::AllocScope;
+
+namespace {
+
+// Drops all UI traffic; the game never runs its loop here
+class NullHost : public OreForged::UIHost {
+public:
+    void Bind(const std::string&, Binding) override {}
+    void Resolve(const std::string&, int, const std::string&) override {}
+    void PublishFacets(std::vector<OreForged::FacetBatcher::Update>) override {}
+    void Run() override {}
+    void Terminate() override {}
+};
+
+} // namespace
+
+// Friend of Game (see Game.h)
+struct GameBenchAccess {
+    static void CollectResource(Game& game, int blockTypeId, int count) {
+        game.CollectResource(blockTypeId, count);
+    }
+    static bool TryMineBlock(Game& game, int x, int y, int z, int blockTypeId) {
+        return game.TryMineBlock(x, y, z, blockTypeId);
+    }
+    static int TryMineBlocks(Game& game, const int* actions, std::size_t count) {
+        return game.TryMineBlocks(actions, count);
+    }
+    static std::shared_ptr<OreForged::World> CurrentWorld(Game& game) {
+        return game.CurrentWorld();
+    }
+    // What a tick sends
+    static void FlushFacets(Game& game) {
+        game.PushInventoryChanges();
+        game.FlushFacets();
+    }
+};
+
+namespace {
+
+// One mined block: inventory, progression and the facet pushes. Arg 1 also
+// sends the inventory patch and flushes facets each time, as a tick after a
+// single mine would.
+void BM_CollectResource(benchmark::State& state) {
+    Game game(std::make_unique<NullHost>());
+    const bool flush = state.range(0) != 0;
+
+    AllocScope allocs;
+    for (auto _ : state) {
+        GameBenchAccess::CollectResource(game, (int)BlockType::Dirt, 1);
+        if (flush) GameBenchAccess::FlushFacets(game);
+    }
+    state.SetItemsProcessed(state.iterations());
+    allocs.Report(state, static_cast<double>(state.iterations()), "op");
+}
+BENCHMARK(BM_CollectResource)->ArgName("flush")->Arg(0)->Arg(1);
+
+// A splash of 16 mined blocks, then the tick's flush: Arg 0 = one interact
+// per block, 1 = one interactBatch. Includes putting the blocks back.
+void BM_MineSplash(benchmark::State& state) {
+    constexpr int SPLASH = 16;
+    Game game(std::make_unique<NullHost>());
+    const auto world = GameBenchAccess::CurrentWorld(game);
+    world->LoadChunksAroundPosition(0, 0, 1);
+    const bool batched = state.range(0) != 0;
+
+    int actions[SPLASH * 4];
+    for (int i = 0; i < SPLASH; i++) {
+        const int action[4] = {i % 4, 5, i / 4, static_cast<int>(BlockType::Dirt)};
+        std::copy(action, action + 4, actions + i * 4);
+    }
+
+    AllocScope allocs;
+    for (auto _ : state) {
+        for (int i = 0; i < SPLASH; i++) world->SetBlock(actions[i * 4], actions[i * 4 + 1], actions[i * 4 + 2], BlockType::Dirt);
+        if (batched) {
+            GameBenchAccess::TryMineBlocks(game, actions, SPLASH);
+        } else {
+            for (int i = 0; i < SPLASH; i++) {
+                GameBenchAccess::TryMineBlock(game, actions[i * 4], actions[i * 4 + 1], actions[i * 4 + 2], actions[i * 4 + 3]);
+            }
+        }
+        GameBenchAccess::FlushFacets(game);
+    }
+    state.SetItemsProcessed(state.iterations() * SPLASH);
+    allocs.Report(state, static_cast<double>(state.iterations()), "op");
+}
+BENCHMARK(BM_MineSplash)->ArgName("batched")->Arg(0)->Arg(1);
+
+// Decoding interact's [x, y, z, blockTypeId]: Arg 0 = nlohmann::json DOM
+// (the fallback path), 1 = ParseIntArgs
+void BM_InteractArgs(benchmark::State& state) {
+    const std::string req = "[-17,12,305,3]";
+    const bool fast = state.range(0) != 0;
+
+    AllocScope allocs;
+    int args[4] = {0, 0, 0, 0};
+    for (auto _ : state) {
+        if (fast) {
+            OreForged::ParseIntArgs(req, args, 4);
+        } else {
+            nlohmann::json parsed = nlohmann::json::parse(req);
+            for (int i = 0; i < 4; i++) args[i] = parsed[i].get<int>();
+        }
+        benchmark::DoNotOptimize(args);
+    }
+    state.SetItemsProcessed(state.iterations());
+    allocs.Report(state, static_cast<double>(state.iterations()), "op");
+}
+BENCHMARK(BM_InteractArgs)->ArgName("fast")->Arg(0)->Arg(1);
+
+} // namespace
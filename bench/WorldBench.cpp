@@ -0,0 +1,280 @@
+#include "AllocCounter.h"
+#include "world/Chunk.h"
+#include "world/World.h"
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace OreForged;
+using OreForged::Bench::AllocScope;
+
+namespace {
+
+constexpr uint32_t BENCH_SEED = 12345;
+
+// LoadChunksAroundPosition(0, 0, 2) loads chunks -3..2 on both axes
+constexpr int LOAD_RADIUS = 2;
+constexpr int LOADED_CHUNKS = (2 * LOAD_RADIUS + 2) * (2 * LOAD_RADIUS + 2);
+
+// Args: chunk size, height, islandFactor in percent
+WorldConfig ConfigFromArgs(const benchmark::State& state) {
+    WorldConfig config;
+    config.size = static_cast<int>(state.range(0));
+    config.height = static_cast<int>(state.range(1));
+    config.islandFactor = state.range(2) / 100.0f;
+    return config;
+}
+
+void ConfigMatrix(benchmark::internal::Benchmark* b) {
+    b->ArgNames({"size", "height", "island"});
+    b->ArgsProduct({{16, 32}, {32, 64}, {20, 100}});
+}
+
+// Cycles through the 4x4 chunks around the island center, so iterations mix
+// land, shore and open water like a real regen does
+void ChunkCoords(int i, int& chunkX, int& chunkZ) {
+    chunkX = (i & 3) - 2;
+    chunkZ = ((i >> 2) & 3) - 2;
+}
+
+Chunk MakeChunk(int i, const WorldConfig& config) {
+    int chunkX, chunkZ;
+    ChunkCoords(i, chunkX, chunkZ);
+    return Chunk(chunkX, chunkZ, config.size, config.height);
+}
+
+std::vector<Chunk> GenerateChunks(const WorldConfig& config) {
+    std::vector<Chunk> chunks;
+    for (int i = 0; i < 16; i++) {
+        chunks.push_back(MakeChunk(i, config));
+        chunks.back().Generate(BENCH_SEED, config.oreMult, config.treeMult, config.islandFactor);
+    }
+    return chunks;
+}
+
+// --- Generation ---
+
+void BM_ChunkGenerate(benchmark::State& state) {
+    const WorldConfig config = ConfigFromArgs(state);
+    AllocScope allocs;
+    int i = 0;
+    for (auto _ : state) {
+        Chunk chunk = MakeChunk(i++, config);
+        chunk.Generate(BENCH_SEED, config.oreMult, config.treeMult, config.islandFactor);
+        benchmark::DoNotOptimize(chunk);
+    }
+    state.SetItemsProcessed(state.iterations());
+    allocs.Report(state, static_cast<double>(state.iterations()), "chunk");
+}
+BENCHMARK(BM_ChunkGenerate)->Apply(ConfigMatrix);
+
+void BM_GenerateOres(benchmark::State& state) {
+    const WorldConfig config = ConfigFromArgs(state);
+    AllocScope allocs;
+    int i = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        allocs.Pause();
+        Chunk chunk = MakeChunk(i++, config);
+        chunk.GenerateTerrain(BENCH_SEED, config.oreMult, config.islandFactor);
+        allocs.Resume();
+        state.ResumeTiming();
+
+        chunk.GenerateOres(BENCH_SEED, config.oreMult);
+        benchmark::DoNotOptimize(chunk);
+    }
+    state.SetItemsProcessed(state.iterations());
+    allocs.Report(state, static_cast<double>(state.iterations()), "chunk");
+}
+BENCHMARK(BM_GenerateOres)->Apply(ConfigMatrix);
+
+void BM_GenerateTrees(benchmark::State& state) {
+    const WorldConfig config = ConfigFromArgs(state);
+    AllocScope allocs;
+    int i = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        allocs.Pause();
+        Chunk chunk = MakeChunk(i++, config);
+        chunk.GenerateTerrain(BENCH_SEED, config.oreMult, config.islandFactor);
+        chunk.GenerateOres(BENCH_SEED, config.oreMult);
+        allocs.Resume();
+        state.ResumeTiming();
+
+        chunk.GenerateTrees(BENCH_SEED, config.treeMult);
+        benchmark::DoNotOptimize(chunk);
+    }
+    state.SetItemsProcessed(state.iterations());
+    allocs.Report(state, static_cast<double>(state.iterations()), "chunk");
+}
+BENCHMARK(BM_GenerateTrees)->Apply(ConfigMatrix);
+
+// --- Serialization (bytes processed = dense block IDs in) ---
+
+void BM_ChunkSerialize(benchmark::State& state) {
+    const WorldConfig config = ConfigFromArgs(state);
+    const std::vector<Chunk> chunks = GenerateChunks(config);
+    AllocScope allocs;
+    std::size_t outBytes = 0;
+    int i = 0;
+    for (auto _ : state) {
+        std::string data = chunks[i++ & 15].Serialize();
+        outBytes += data.size();
+        benchmark::DoNotOptimize(data);
+    }
+    const double iterations = static_cast<double>(state.iterations());
+    state.SetBytesProcessed(state.iterations() * config.size * config.size * config.height);
+    state.counters["wire_bytes/chunk"] = outBytes / iterations;
+    allocs.Report(state, iterations, "chunk");
+}
+BENCHMARK(BM_ChunkSerialize)->Apply(ConfigMatrix);
+
+void BM_ChunkSerializeBinary(benchmark::State& state) {
+    const WorldConfig config = ConfigFromArgs(state);
+    const std::vector<Chunk> chunks = GenerateChunks(config);
+    AllocScope allocs;
+    int i = 0;
+    for (auto _ : state) {
+        std::vector<uint8_t> data = chunks[i++ & 15].SerializeBinary();
+        benchmark::DoNotOptimize(data);
+    }
+    state.SetBytesProcessed(state.iterations() * config.size * config.size * config.height);
+    allocs.Report(state, static_cast<double>(state.iterations()), "chunk");
+}
+BENCHMARK(BM_ChunkSerializeBinary)->Apply(ConfigMatrix);
+
+// --- World loading (one regen's worth of chunks per iteration) ---
+
+// Arg 3: 0 = cold (cache disabled), 1 = every chunk served by the chunk cache
+void BM_LoadChunksAroundPosition(benchmark::State& state) {
+    WorldConfig config = ConfigFromArgs(state);
+    const bool cached = state.range(3) != 0;
+
+    World world(BENCH_SEED);
+    if (!cached) world.SetCacheBudget(0);
+    world.Regenerate(BENCH_SEED, config);
+    world.LoadChunksAroundPosition(0, 0, LOAD_RADIUS); // Warms the cache
+
+    AllocScope allocs;
+    for (auto _ : state) {
+        state.PauseTiming();
+        allocs.Pause();
+        world.Regenerate(BENCH_SEED, config);
+        allocs.Resume();
+        state.ResumeTiming();
+
+        world.LoadChunksAroundPosition(0, 0, LOAD_RADIUS);
+    }
+    state.SetItemsProcessed(state.iterations() * LOADED_CHUNKS);
+    state.counters["time/chunk"] = benchmark::Counter(LOADED_CHUNKS,
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    allocs.Report(state, static_cast<double>(state.iterations()) * LOADED_CHUNKS, "chunk");
+    // Stays flat across iterations once the dropped world's buffers are recycled
+    state.counters["pooled_KB"] = BlockStorage::PooledBytes() / 1024.0;
+}
+BENCHMARK(BM_LoadChunksAroundPosition)
+    ->ArgNames({"size", "height", "island", "cached"})
+    ->ArgsProduct({{16, 32}, {32, 64}, {20, 100}, {0, 1}})
+    ->UseRealTime() // Generation runs on worker threads
+    ->Unit(benchmark::kMillisecond);
+
+// --- Block access on a loaded world ---
+
+struct BlockCoord {
+    int x, y, z;
+};
+
+// Arg 0: 0 = sequential (x fastest, like a mesher), 1 = uniformly random
+std::vector<BlockCoord> AccessPattern(const WorldConfig& config, bool random) {
+    const int minXZ = -(LOAD_RADIUS + 1) * config.size;
+    const int span = (2 * LOAD_RADIUS + 2) * config.size;
+    std::vector<BlockCoord> coords;
+    coords.reserve(1 << 16);
+    if (random) {
+        std::mt19937 rng(BENCH_SEED);
+        std::uniform_int_distribution<int> xz(0, span - 1), y(0, config.height - 1);
+        while (coords.size() < coords.capacity()) {
+            coords.push_back({minXZ + xz(rng), y(rng), minXZ + xz(rng)});
+        }
+    } else {
+        for (int y = 0; y < config.height && coords.size() < coords.capacity(); y++) {
+            for (int z = 0; z < span && coords.size() < coords.capacity(); z++) {
+                for (int x = 0; x < span && coords.size() < coords.capacity(); x++) {
+                    coords.push_back({minXZ + x, y, minXZ + z});
+                }
+            }
+        }
+    }
+    return coords;
+}
+
+WorldConfig AccessConfig() {
+    WorldConfig config;
+    config.size = 32;
+    config.height = 32;
+    return config;
+}
+
+void BM_WorldGetBlock(benchmark::State& state) {
+    const WorldConfig config = AccessConfig();
+    World world(BENCH_SEED);
+    world.Regenerate(BENCH_SEED, config);
+    world.LoadChunksAroundPosition(0, 0, LOAD_RADIUS);
+    const std::vector<BlockCoord> coords = AccessPattern(config, state.range(0) != 0);
+
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const BlockCoord& c = coords[i++ & (coords.size() - 1)];
+        benchmark::DoNotOptimize(world.GetBlock(c.x, c.y, c.z));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_WorldGetBlock)->ArgName("random")->Arg(0)->Arg(1);
+
+void BM_WorldSetBlock(benchmark::State& state) {
+    const WorldConfig config = AccessConfig();
+    World world(BENCH_SEED);
+    world.Regenerate(BENCH_SEED, config);
+    world.LoadChunksAroundPosition(0, 0, LOAD_RADIUS);
+    const std::vector<BlockCoord> coords = AccessPattern(config, state.range(0) != 0);
+
+    AllocScope allocs;
+    std::size_t i = 0;
+    for (auto _ : state) {
+        const BlockCoord& c = coords[i & (coords.size() - 1)];
+        // Alternate so repeated passes keep changing blocks
+        world.SetBlock(c.x, c.y, c.z, (i >> 16) & 1 ? BlockType::Stone : BlockType::Air);
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+    allocs.Report(state, static_cast<double>(state.iterations()), "op");
+}
+BENCHMARK(BM_WorldSetBlock)->ArgName("random")->Arg(0)->Arg(1);
+
+// Camera-style picking rays: from high above the loaded area, aimed at
+// random points on it, like clicks with the game's overhead camera
+void BM_WorldRaycast(benchmark::State& state) {
+    const WorldConfig config = AccessConfig();
+    World world(BENCH_SEED);
+    world.Regenerate(BENCH_SEED, config);
+    world.LoadChunksAroundPosition(0, 0, LOAD_RADIUS);
+
+    const float span = static_cast<float>(LOAD_RADIUS * config.size);
+    std::mt19937 rng(BENCH_SEED);
+    std::uniform_real_distribution<float> target(-span, span);
+    std::vector<BlockCoord> targets(1 << 10);
+    for (BlockCoord& t : targets) t = {static_cast<int>(target(rng)), 0, static_cast<int>(target(rng))};
+
+    std::size_t i = 0, hits = 0;
+    for (auto _ : state) {
+        const BlockCoord& t = targets[i++ & (targets.size() - 1)];
+        const RaycastHit hit = world.Raycast(30.0f, 100.0f, 30.0f, t.x - 30.0f, -100.0f, t.z - 30.0f, 256.0f);
+        hits += hit.hit;
+        benchmark::DoNotOptimize(hit);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_rate"] = static_cast<double>(hits) / static_cast<double>(state.iterations());
+}
+BENCHMARK(BM_WorldRaycast);
+
+} // namespace
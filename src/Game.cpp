@@ -1,43 +1,22 @@
 #include "Game.h"
-#include "webview.h"
+#include "core/BindingArgs.h"
+#include "core/BoundedQueue.h"
+#include "core/Profiler.h"
+#include "world/ChunkMesher.h"
 #include <iostream>
 #include <cmath>
 #include <thread>
 #include <algorithm>
-#ifdef _WIN32
-  #include <Windows.h>
-#elif __linux__
-  #include <unistd.h>
-  #include <limits.h>
-#elif __APPLE__
-  #include <mach-o/dyld.h>
-#endif
+#include <fstream>
+#include <future>
+#include <limits>
+#include <map>
 #include <nlohmann/json.hpp>
 
 using json = nlohmann::json;
 
-struct WebviewWrapper {
-    webview::webview w;
-    WebviewWrapper(bool debug, void* window) : w(debug, window) {}
-};
-
-Game::Game() {
-    // Initialize Inventory (Defaults to 0 but explicit for clarity)
-    m_state.inventory[(int)BlockType::Air] = 0;
-    m_state.inventory[(int)BlockType::Grass] = 0;
-    m_state.inventory[(int)BlockType::Dirt] = 0;
-    m_state.inventory[(int)BlockType::Stone] = 0;
-    m_state.inventory[(int)BlockType::Water] = 0;
-    m_state.inventory[(int)BlockType::Wood] = 0;
-    m_state.inventory[(int)BlockType::Leaves] = 0;
-    m_state.inventory[(int)BlockType::Bedrock] = 0;
-    m_state.inventory[(int)BlockType::Sand] = 0;
-    m_state.inventory[(int)BlockType::Coal] = 0;
-    m_state.inventory[(int)BlockType::Iron] = 0;
-    m_state.inventory[(int)BlockType::Gold] = 0;
-    m_state.inventory[(int)BlockType::Diamond] = 0;
-    m_state.inventory[(int)BlockType::Bronze] = 0;
-
+Game::Game(std::unique_ptr<OreForged::UIHost> host, std::filesystem::path saveDir)
+    : m_host(std::move(host)), m_saveDir(std::move(saveDir)) {
     InitUI();
 
     // Fix: Ensure initial world matches Level 0 Regeneration logic
@@ -48,25 +27,61 @@ Game::Game() {
     startConfig.islandFactor = 0.20f; // New Level 0 baseFactor (gentler start)
     startConfig.oreMult = 1.0f;
     startConfig.treeMult = 1.0f;
-    m_state.world.Regenerate(12345, startConfig);
+    uint32_t seed = 12345;
+
+    // A saved game picks up its world where it left off: the chunks are read
+    // from the region files as they are loaded instead of being generated.
+    // Without a readable level.json the regions are left alone: their stamps
+    // keep another world's chunks out, and they are only deleted once a save
+    // has written a level.json for the world that replaces them.
+    if (!m_saveDir.empty()) {
+        LoadGame(seed, startConfig);
+        m_regions = std::make_shared<OreForged::RegionStore>(m_saveDir / "region", seed, startConfig);
+    }
+
+    m_state.world->Regenerate(seed, startConfig);
+    m_state.world->SetRegionStore(m_regions);
+
+    m_scheduler.Every(TICKS_PER_SECOND, [this]() { PushTickStats(); });
+    m_scheduler.Every(TICKS_PER_SECOND, [this]() { PushPerfStats(); });
+    if (m_regions) {
+        m_scheduler.Every(AUTOSAVE_INTERVAL_TICKS, [this]() { SaveGame(); });
+    }
 }
 
 Game::~Game() = default;
 
-void Game::InitUI() {
-    // Initialize webview with debug enabled
-    m_webview = std::make_unique<WebviewWrapper>(true, nullptr);
-    m_webview->w.set_title("OreForged");
-    m_webview->w.set_size(1280, 720, WEBVIEW_HINT_NONE);
+void Game::BindCommand(const std::string& name, OreForged::UIHost::Binding handler) {
+    // The call returns right away; the handler (and its Resolve) runs on the
+    // game loop thread at the start of the next tick
+#ifdef OREFORGED_PROFILING
+    // Both halves of a binding's latency: waiting in the queue, then running
+    const int queuedId = OreForged::Profiler::RegisterScope("Binding queue wait");
+    const int runId = OreForged::Profiler::RegisterScope("Binding " + name);
+    m_host->Bind(name, [this, handler = std::move(handler), queuedId, runId](const std::string& seq, const std::string& req) {
+        const auto posted = std::chrono::steady_clock::now();
+        m_scheduler.Post([handler, seq, req, queuedId, runId, posted]() {
+            OreForged::Profiler::Record(queuedId, posted, std::chrono::steady_clock::now());
+            OreForged::ProfileScope scope(runId);
+            handler(seq, req);
+        });
+    });
+#else
+    m_host->Bind(name, [this, handler = std::move(handler)](const std::string& seq, const std::string& req) {
+        m_scheduler.Post([handler, seq, req]() { handler(seq, req); });
+    });
+#endif
+}
 
+void Game::InitUI() {
     // Bind logFromUI
-    m_webview->w.bind("logFromUI", [&](std::string seq, std::string req, void* /*arg*/) {
+    m_host->Bind("logFromUI", [&](const std::string& seq, const std::string& req) {
         std::cout << "UI Log: " << req << std::endl;
-        m_webview->w.resolve(seq, 0, "\"Logged successfully\"");
-    }, nullptr);
+        m_host->Resolve(seq, 0, "\"Logged successfully\"");
+    });
 
     // Bind updateState (Legacy/Config)
-    m_webview->w.bind("updateState", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("updateState", [&](const std::string& seq, const std::string& req) {
         try {
             auto args = json::parse(req);
             if (args.is_array() && args.size() >= 2) {
@@ -78,60 +93,142 @@ void Game::InitUI() {
         } catch (const std::exception& e) {
             std::cerr << "JSON Parse Error: " << e.what() << std::endl;
         }
-        m_webview->w.resolve(seq, 0, "\"OK\"");
-    }, nullptr);
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
 
     // Bind uiReady
-    m_webview->w.bind("uiReady", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("uiReady", [&](const std::string& seq, const std::string& req) {
         OnUIReady();
-        m_webview->w.resolve(seq, 0, "\"OK\"");
-    }, nullptr);
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
+
+    // Bind chunkAck: UI finished building a staged_ chunk payload (the
+    // regen sender's window; live sends are paced per tick, not acked)
+    m_host->Bind("chunkAck", [&](const std::string& seq, const std::string& req) {
+        m_chunkAcks.Release();
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
+
+    // Bind saveGame
+    BindCommand("saveGame", [&](const std::string& seq, const std::string& req) {
+        SaveGame();
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
 
     // Bind quitApplication
-    m_webview->w.bind("quitApplication", [&](std::string seq, std::string req, void* /*arg*/) {
+    m_host->Bind("quitApplication", [&](const std::string& seq, const std::string& req) {
         std::cout << "Quit application requested from UI" << std::endl;
-        m_isRunning = false;
-        m_webview->w.terminate();
-        m_webview->w.resolve(seq, 0, R"({"success": true})");
-    }, nullptr);
+        m_host->Terminate(); // Run() stops the game loop once the host returns
+        m_host->Resolve(seq, 0, R"({"success": true})");
+    });
 
     // --- GAME LOGIC BINDINGS ---
 
-    // interact: ["blockType"]
-    // interact: [blockTypeId (int)]
-    m_webview->w.bind("interact", [&](std::string seq, std::string req, void* /*arg*/) {
+    // interact: [x, y, z, blockTypeId] (world coordinates of the mined block)
+    BindCommand("interact", [&](const std::string& seq, const std::string& req) {
+        // The UI's most frequent call; nearly always a plain array of four ints
+        int args[4];
+        if (OreForged::ParseIntArgs(req, args, 4)) {
+            TryMineBlock(args[0], args[1], args[2], args[3]);
+            m_host->Resolve(seq, 0, "\"OK\"");
+            return;
+        }
+        
+        std::vector<int> list;
+        if (!OreForged::ParseIntListJson(req, list, 4)) {
+            std::cerr << "Interact Error: expected an array of integers" << std::endl;
+            m_host->Resolve(seq, 1, "\"Error\"");
+            return;
+        }
+        if (list.size() >= 4) {
+            TryMineBlock(list[0], list[1], list[2], list[3]);
+        }
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
+
+    // interactBatch: [x, y, z, blockTypeId, x, y, z, blockTypeId, ...], or
+    // [[x, y, z, blockTypeId], ...]. One round trip and one stats update for
+    // a whole splash; resolves with {"mined": n, "rejected": m}. Either form
+    // is read only up to MAX_INTERACT_BATCH actions.
+    BindCommand("interactBatch", [&](const std::string& seq, const std::string& req) {
+        constexpr std::size_t maxValues = MAX_INTERACT_BATCH * 4;
+        std::vector<int> actions;
+        if (!OreForged::ParseIntList(req, actions, maxValues) &&
+            !OreForged::ParseIntListJson(req, actions, 4, maxValues)) {
+            std::cerr << "InteractBatch Error: expected an array of actions" << std::endl;
+            m_host->Resolve(seq, 1, "\"Error\"");
+            return;
+        }
+        if (actions.size() > maxValues) {
+            m_host->Resolve(seq, 1, "\"Batch too large\"");
+            return;
+        }
+
+        const std::size_t count = actions.size() / 4;
+        const int mined = TryMineBlocks(actions.data(), count);
+        m_host->Resolve(seq, 0, "{\"mined\":" + std::to_string(mined) +
+                                ",\"rejected\":" + std::to_string(static_cast<int>(count) - mined) + "}");
+    });
+
+    // raycast: [ox, oy, oz, dx, dy, dz, maxDistance?] (a camera ray in world
+    // space). Resolves with the first block hit, as the game sees it:
+    // {"hit": true, "x", "y", "z", "normal": [nx, ny, nz], "distance", "type"}
+    // or {"hit": false}. Queued like the edits, so it sees every earlier one.
+    // An origin beyond MAX_RAYCAST_COORD (or a number no float can hold) is
+    // an error.
+    BindCommand("raycast", [&](const std::string& seq, const std::string& req) {
         try {
-            auto parsed = json::parse(req);
-            json args = parsed;
-            // Robust check
-            if (parsed.is_array() && !parsed.empty() && parsed[0].is_string()) {
-                try {
-                    auto inner = json::parse(parsed[0].get<std::string>());
-                    if (inner.is_array()) args = inner;
-                } catch(...) {}
+            json args = json::parse(req);
+            if (args.is_array() && args.size() == 1 && args[0].is_string()) {
+                args = json::parse(args[0].get<std::string>());
+            }
+            if (!args.is_array() || args.size() < 6) {
+                m_host->Resolve(seq, 1, "\"Expected [ox, oy, oz, dx, dy, dz]\"");
+                return;
             }
 
-            if (args.is_array() && args.size() >= 1) {
-                // Now expecting integer ID
-                int blockTypeId = 0;
-                if (args[0].is_number()) blockTypeId = args[0].get<int>();
-                else if (args[0].is_string()) {
-                    // Fallback try parse
-                    try { blockTypeId = std::stoi(args[0].get<std::string>()); } catch(...) {}
+            // Checked as doubles: a float or int conversion out of range is undefined
+            float ray[6];
+            for (int i = 0; i < 6; i++) {
+                const double value = args[i].get<double>();
+                const double limit = i < 3 ? OreForged::MAX_RAYCAST_COORD : std::numeric_limits<float>::max();
+                if (!(std::abs(value) <= limit)) {
+                    m_host->Resolve(seq, 1, "\"Ray out of range\"");
+                    return;
                 }
-                
-                CollectResource(blockTypeId, 1);
+                ray[i] = static_cast<float>(value);
+            }
+            float maxDistance = MAX_RAYCAST_DISTANCE;
+            if (args.size() > 6 && args[6].is_number()) {
+                const double distance = args[6].get<double>();
+                if (std::isnan(distance)) {
+                    m_host->Resolve(seq, 1, "\"Ray out of range\"");
+                    return;
+                }
+                maxDistance = static_cast<float>((std::min)(distance, static_cast<double>(MAX_RAYCAST_DISTANCE)));
             }
-            m_webview->w.resolve(seq, 0, "\"OK\"");
+
+            const OreForged::RaycastHit hit =
+                CurrentWorld()->Raycast(ray[0], ray[1], ray[2], ray[3], ray[4], ray[5], maxDistance);
+            json result = {{"hit", hit.hit}};
+            if (hit.hit) {
+                result["x"] = hit.x;
+                result["y"] = hit.y;
+                result["z"] = hit.z;
+                result["normal"] = {hit.normalX, hit.normalY, hit.normalZ};
+                result["distance"] = hit.distance;
+                result["type"] = static_cast<int>(hit.type);
+            }
+            m_host->Resolve(seq, 0, result.dump());
         } catch (std::exception& e) {
-            std::cerr << "Interact Error: " << e.what() << std::endl;
-            m_webview->w.resolve(seq, 1, "\"Error\"");
+            std::cerr << "Raycast Error: " << e.what() << std::endl;
+            m_host->Resolve(seq, 1, "\"Error\"");
         }
-    }, nullptr);
+    });
 
     // craft: [{"recipe_json"}]
     // craft: [{"recipe_json"}]
-    m_webview->w.bind("craft", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("craft", [&](const std::string& seq, const std::string& req) {
         try {
             auto parsed = json::parse(req);
             json args = parsed;
@@ -150,16 +247,16 @@ void Game::InitUI() {
                 std::string recipeStr = args[0].is_string() ? args[0].get<std::string>() : args[0].dump();
                 TryCraft(recipeStr);
             }
-            m_webview->w.resolve(seq, 0, "\"OK\"");
+            m_host->Resolve(seq, 0, "\"OK\"");
         } catch (std::exception& e) {
             std::cerr << "Craft Error: " << e.what() << std::endl;
-            m_webview->w.resolve(seq, 1, "\"Error\"");
+            m_host->Resolve(seq, 1, "\"Error\"");
         }
-    }, nullptr);
+    });
 
     // upgrade: ["type"]
     // upgrade: ["type"]
-    m_webview->w.bind("upgrade", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("upgrade", [&](const std::string& seq, const std::string& req) {
         try {
             auto parsed = json::parse(req);
             json args = parsed;
@@ -173,21 +270,21 @@ void Game::InitUI() {
             if (args.is_array() && args.size() >= 1) {
                 TryBuyUpgrade(args[0].get<std::string>());
             }
-            m_webview->w.resolve(seq, 0, "\"OK\"");
+            m_host->Resolve(seq, 0, "\"OK\"");
         } catch (std::exception& e) {
             std::cerr << "Upgrade Error: " << e.what() << std::endl;
-            m_webview->w.resolve(seq, 1, "\"Error\"");
+            m_host->Resolve(seq, 1, "\"Error\"");
         }
-    }, nullptr);
+    });
 
     // repairTool
-    m_webview->w.bind("repairTool", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("repairTool", [&](const std::string& seq, const std::string& req) {
         TryRepair();
-        m_webview->w.resolve(seq, 0, "\"OK\"");
-    }, nullptr);
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
 
     // regenerateWorld: [seed, autoRandomize (opt)]
-    m_webview->w.bind("regenerateWorld", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("regenerateWorld", [&](const std::string& seq, const std::string& req) {
         try {
             auto parsed = json::parse(req);
             json args = parsed;
@@ -211,27 +308,27 @@ void Game::InitUI() {
             
             TryRegenerate(seedDecStr, autoRand);
             
-            m_webview->w.resolve(seq, 0, "\"OK\"");
+            m_host->Resolve(seq, 0, "\"OK\"");
         } catch (const std::exception& e) {
             std::cerr << "Error regenerating world: " << e.what() << std::endl;
-            m_webview->w.resolve(seq, 1, "\"Error\"");
+            m_host->Resolve(seq, 1, "\"Error\"");
         }
-    }, nullptr);
+    });
 
     // Unlock Crafting Cheat / Force
-    m_webview->w.bind("unlockCrafting", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("unlockCrafting", [&](const std::string& seq, const std::string& req) {
         UnlockCrafting();
-        m_webview->w.resolve(seq, 0, "\"OK\"");
-    }, nullptr);
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
 
     // Reset Progression
-    m_webview->w.bind("resetProgression", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("resetProgression", [&](const std::string& seq, const std::string& req) {
         ResetProgression();
-        m_webview->w.resolve(seq, 0, "\"OK\"");
-    }, nullptr);
+        m_host->Resolve(seq, 0, "\"OK\"");
+    });
 
     // Toggle Water Currency
-    m_webview->w.bind("toggleWaterCurrency", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("toggleWaterCurrency", [&](const std::string& seq, const std::string& req) {
         try {
             auto args = json::parse(req);
             bool enabled = false;
@@ -244,14 +341,30 @@ void Game::InitUI() {
                 }
              }
             ToggleWaterCurrency(enabled);
-            m_webview->w.resolve(seq, 0, "\"OK\"");
+            m_host->Resolve(seq, 0, "\"OK\"");
+        } catch(...) {
+             m_host->Resolve(seq, 1, "\"Error\"");
+        }
+    });
+
+    // Native Meshing: [enabled] (internal switch, marks the loaded chunks for resending)
+    BindCommand("setNativeMeshing", [&](const std::string& seq, const std::string& req) {
+        try {
+            auto args = json::parse(req);
+            bool enabled = false;
+            if (args.is_array() && !args.empty()) {
+                if (args[0].is_boolean()) enabled = args[0];
+                else if (args[0].is_string()) enabled = args[0].get<std::string>() == "true";
+            }
+            SetNativeMeshing(enabled);
+            m_host->Resolve(seq, 0, "\"OK\"");
         } catch(...) {
-             m_webview->w.resolve(seq, 1, "\"Error\"");
+            m_host->Resolve(seq, 1, "\"Error\"");
         }
-    }, nullptr);
+    });
 
     // Instant Cheat Check (triggers on blur/finish editing)
-    m_webview->w.bind("instantCheatCheck", [&](std::string seq, std::string req, void* /*arg*/) {
+    BindCommand("instantCheatCheck", [&](const std::string& seq, const std::string& req) {
         try {
             auto args = json::parse(req);
             uint32_t seed = 0;
@@ -275,83 +388,88 @@ void Game::InitUI() {
                 PushPlayerStats();
             }
             
-            m_webview->w.resolve(seq, 0, "\"OK\"");
+            m_host->Resolve(seq, 0, "\"OK\"");
         } catch(...) {
-             m_webview->w.resolve(seq, 1, "\"Error\"");
+             m_host->Resolve(seq, 1, "\"Error\"");
         }
-    }, nullptr);
-
-    // Portable executable path finding (Load UI)
-    std::filesystem::path exePath;
-#ifdef _WIN32
-    char path[MAX_PATH];
-    GetModuleFileNameA(NULL, path, MAX_PATH);
-    exePath = std::filesystem::path(path);
-#elif __linux__
-    char result[PATH_MAX];
-    ssize_t count = readlink("/proc/self/exe", result, PATH_MAX);
-    exePath = std::filesystem::path(std::string(result, (count > 0) ? count : 0));
-#elif __APPLE__
-    char path[1024];
-    uint32_t size = sizeof(path);
-    if (_NSGetExecutablePath(path, &size) == 0)
-        exePath = std::filesystem::path(path);
-#endif
-
-    auto exeDir = exePath.parent_path();
-    auto htmlPath = exeDir / "ui" / "index.html";
-    std::string htmlPathStr = htmlPath.string();
-    std::replace(htmlPathStr.begin(), htmlPathStr.end(), '\\', '/');
-    m_webview->w.navigate("file:///" + htmlPathStr);
+    });
 }
 
 void Game::Run() {
     m_isRunning = true;
     m_gameLoopThread = std::thread(&Game::GameLoop, this);
-    if (m_webview) {
-        m_webview->w.run();
+    m_host->Run();
+
+    // Let the loop get through the commands queued before the host stopped
+    // (a late regen request starts its thread there)
+    std::promise<void> drained;
+    m_scheduler.Post([&drained]() { drained.set_value(); });
+    drained.get_future().wait();
+
+    // A headless script can end mid-regeneration; the detached regen threads
+    // still need the game loop to drain their chunks
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(m_regenMutex);
+            if (m_regenThreads == 0) break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
     m_isRunning = false;
     if (m_gameLoopThread.joinable()) {
         m_gameLoopThread.join();
     }
+    
+    // Commands the last tick didn't get to, then whatever they and the last
+    // ticks left buffered (a headless host still delivers it)
+    m_scheduler.Drain();
+    FlushFacets();
+    
+    SaveGame();
+
+    const OreForged::TickStats& stats = m_scheduler.GetTotalStats();
+    std::cout << "Game loop: " << stats.ticks << " ticks, " << stats.commands << " commands, "
+              << stats.overruns << " overruns (worst " << stats.worstUs / 1000.0 << " ms), "
+              << stats.skipped << " skipped" << std::endl;
 }
 
 void Game::OnUIReady() {
     std::cout << "UI Ready. Syncing State..." << std::endl;
     m_uiReady = true;
+    m_chunkAcks.Reset(); // A reloaded UI will never ack earlier sends
 
     PushInventory();
     PushPlayerStats();
     PushProgression();
-
-    // Send Loaded Chunks
-    auto chunks = m_state.world.GetLoadedChunks();
-    for (const auto* chunk : chunks) {
-        std::string chunkData = chunk->Serialize();
-        UpdateFacetJSON("chunk_data", chunkData);
-    }
+    UpdateFacet("native_meshing", m_state.nativeMeshing ? "true" : "false");
+    // Restored from a save, so the UI can't assume its defaults
+    UpdateFacet("unlock_crafting", m_state.craftingUnlocked ? "true" : "false");
+    UpdateFacet("count_water", m_state.countWaterAsCurrency ? "true" : "false");
+    UpdateFacet("world_seed", std::to_string(CurrentWorld()->GetSeed()));
+
+    // Sent over the next ticks, nearest first (see PushDirtyChunks)
+    CurrentWorld()->MarkAllDirty();
 }
 
 void Game::GameLoop() {
-    using clock = std::chrono::high_resolution_clock;
-    auto next_tick = clock::now();
-    
-    while (m_isRunning) {
-        Update();
-        next_tick += std::chrono::milliseconds(1000 / 60); // 60 TPS
-        std::this_thread::sleep_until(next_tick);
-    }
+    PROFILE_THREAD("game loop");
+    m_scheduler.Run(m_isRunning, [this]() { Update(); });
 }
 
 void Game::Update() {
-    if (m_state.isGenerating) return;
-
+    PROFILE_SCOPE("Game::Update");
+    // Everything pushed since the last tick (this tick's commands and jobs,
+    // the regen thread) goes out as one eval
+    PushDirtyChunks();
+    PushInventoryChanges();
+    FlushFacets();
+
+    // The world is thread-safe, so ticks keep running through a regeneration
     m_state.tickCount++;
     
     // Initial Gen
     if (m_state.tickCount == 1) {
-        m_state.world.LoadChunksAroundPosition(0, 0, 2);
+        CurrentWorld()->LoadChunksAroundPosition(0, 0, WORLD_CHUNK_RADIUS);
     }
     
     if (m_uiReady && m_state.tickCount % 60 == 0) {
@@ -361,78 +479,85 @@ void Game::Update() {
 
 // --- LOGIC IMPLEMENTATION ---
 
-// Helper to determine if block is mineable by tool
-bool CanMine(int blockType, ToolTier tool) {
-    if (blockType == (int)BlockType::Bedrock) return false;
-    if (blockType == (int)BlockType::Air) return false;
-    // Water is now mineable
-
-    // Hand can mine basic resources
-    if (tool == ToolTier::HAND) {
-        return blockType == (int)BlockType::Grass || 
-               blockType == (int)BlockType::Dirt || 
-               blockType == (int)BlockType::Wood || 
-               blockType == (int)BlockType::Leaves || 
-               blockType == (int)BlockType::Sand ||
-               blockType == (int)BlockType::Water;
-    }
-    
-    // Picks can mine everything Hand can + deeper
-    // Simplified logic: Tiers enable specific blocks
-    // This should match frontend "canMineBlock" if possible
-    
-    // Stone Pick -> Stone, Coal, Iron
-    if (tool == ToolTier::STONE_PICK || tool >= ToolTier::STONE_PICK) {
-        if (blockType == (int)BlockType::Stone || blockType == (int)BlockType::Coal || blockType == (int)BlockType::Iron || blockType == (int)BlockType::Bronze) return true;
-    }
-    
-    // Bronze/Iron -> Gold
-    if (tool >= ToolTier::BRONZE_PICK) {
-        if (blockType == (int)BlockType::Gold) return true;
-    }
-    
-    // Iron -> Diamond
-    if (tool >= ToolTier::IRON_PICK) {
-        if (blockType == (int)BlockType::Diamond) return true;
-    }
+bool Game::TryMineBlock(int x, int y, int z, int blockTypeId) {
+    const int action[4] = {x, y, z, blockTypeId};
+    return TryMineBlocks(action, 1) == 1;
+}
+
+int Game::TryMineBlocks(const int* actions, std::size_t count) {
+    // World swaps run on this thread too, so the world can't change mid-edit
+    const auto world = CurrentWorld();
+    const OreForged::WorldConfig config = world->GetConfig();
+    const int reach = (WORLD_CHUNK_RADIUS + 1) * config.size; // Past every loaded chunk
+
+    int mined = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        const int x = actions[i * 4], y = actions[i * 4 + 1], z = actions[i * 4 + 2];
+        const int blockTypeId = actions[i * 4 + 3];
+
+        // Outside the world, or not a block at all: nothing there to check or undo
+        if (y < 0 || y >= config.height || x < -reach || x >= reach || z < -reach || z >= reach ||
+            !OreForged::IsValidBlockId(blockTypeId)) {
+            continue;
+        }
+
+        // The world is authoritative: the UI must be mining what is actually there
+        OreForged::Block block = world->GetBlock(x, y, z);
+        if (static_cast<int>(block.type) != blockTypeId || !OreForged::CanMine(blockTypeId, m_state.player.currentTool)) {
+            // Undo any optimistic removal on the UI side
+            PushBlockDelta(x, y, z, static_cast<int>(block.type));
+            continue;
+        }
 
-    // Always allow basic blocks if tool is better than hand
-    if (blockType == (int)BlockType::Grass || 
-        blockType == (int)BlockType::Dirt || 
-        blockType == (int)BlockType::Wood || 
-        blockType == (int)BlockType::Leaves || 
-        blockType == (int)BlockType::Sand ||
-        blockType == (int)BlockType::Water) return true;
+        world->SetBlock(x, y, z, OreForged::BlockType::Air);
+        PushBlockDelta(x, y, z, static_cast<int>(OreForged::BlockType::Air));
 
-    return false;
+        // Native meshes can't be patched on the UI side; every mesh the edit
+        // can show up in (neighbours share border faces and AO) is resent,
+        // once per tick however many edits it gets
+        if (m_state.nativeMeshing) {
+            world->MarkEdited(x, z);
+        }
+
+        CreditResource(blockTypeId, 1);
+        mined++;
+    }
+
+    if (mined > 0) {
+        PushPlayerStats();
+        PushProgression();
+    }
+    return mined;
 }
 
 void Game::CollectResource(int blockTypeId, int count) {
+    if (CreditResource(blockTypeId, count)) {
+        PushPlayerStats();
+        PushProgression();
+    }
+}
+
+bool Game::CreditResource(int blockTypeId, int count) {
     // Validation
-    if (!CanMine(blockTypeId, m_state.player.currentTool)) {
-        return;
+    if (!OreForged::CanMine(blockTypeId, m_state.player.currentTool) || blockTypeId <= 0) {
+        return false;
     }
 
-    if (blockTypeId > 0) {
-        m_state.inventory[blockTypeId] += count;
-        
-        bool isWater = (blockTypeId == (int)BlockType::Water);
-        if (!isWater || (isWater && m_state.countWaterAsCurrency)) {
-             m_state.progression.totalMined += count;
-        }
+    m_state.inventory.Add(blockTypeId, count);
+    
+    bool isWater = (blockTypeId == (int)BlockType::Water);
+    if (OreForged::BLOCK_INFO[blockTypeId].currency && (!isWater || m_state.countWaterAsCurrency)) {
+         m_state.progression.totalMined += count;
+    }
 
-        // Tool Damage
-        if (m_state.player.currentTool != ToolTier::HAND && !m_state.player.isToolBroken) {
-            m_state.player.toolHealth = (std::max)(0.0f, m_state.player.toolHealth - 2.0f);
-            if (m_state.player.toolHealth <= 0) {
-                m_state.player.isToolBroken = true;
-            }
+    // Tool Damage
+    if (m_state.player.currentTool != ToolTier::HAND && !m_state.player.isToolBroken) {
+        m_state.player.toolHealth = (std::max)(0.0f, m_state.player.toolHealth - 2.0f);
+        if (m_state.player.toolHealth <= 0) {
+            m_state.player.isToolBroken = true;
         }
-
-        PushInventory();
-        PushPlayerStats();
-        PushProgression();
     }
+    return true;
 }
 
 void Game::TryCraft(const std::string& recipeJson) {
@@ -471,15 +596,10 @@ void Game::TryCraft(const std::string& recipeJson) {
 
     // Check Affordability
     for (const auto& [item, amount] : cost) {
-        int current = m_state.inventory[item];
-        if (current < amount) {
+        if (!OreForged::IsValidBlockId(item)) {
             return;
         }
-    }
-
-    // Check Affordability
-    for (const auto& [item, amount] : cost) {
-        int current = m_state.inventory[item];
+        int current = m_state.inventory.Get(item);
         if (current < amount) {
             return;
         }
@@ -487,7 +607,7 @@ void Game::TryCraft(const std::string& recipeJson) {
 
     // Deduct
     for (const auto& [item, amount] : cost) {
-        m_state.inventory[item] -= amount;
+        m_state.inventory.Add(item, -amount);
         // NOTE: Does spending inventory count towards "Spent on Current Gen"?
         // Legacy: "spentOnCurrentGen" likely tracked 'mined blocks spent on UPGRADES or REGENS'?
         // The formula '30 - spent' implies spending reduces the cost to leave.
@@ -509,20 +629,10 @@ void Game::TryCraft(const std::string& recipeJson) {
     if (recipe.contains("result")) {
         int tier = recipe["result"];
         m_state.player.currentTool = static_cast<ToolTier>(tier);
-        m_state.player.toolHealth = 100.0f; // Reset health
         m_state.player.isToolBroken = false;
-        
-        // Hardcoded max healths
-        float maxHealth = 100.0f;
-        if (tier == 2) maxHealth = 150.0f;
-        if (tier == 3) maxHealth = 250.0f;
-        if (tier == 4) maxHealth = 500.0f;
-        if (tier == 5) maxHealth = 300.0f;
-        if (tier == 6) maxHealth = 1000.0f;
-        m_state.player.toolHealth = maxHealth;
+        m_state.player.toolHealth = OreForged::GetToolInfo(m_state.player.currentTool).maxHealth;
     }
 
-    PushInventory();
     PushPlayerStats();
 }
 
@@ -553,30 +663,16 @@ void Game::TryBuyUpgrade(const std::string& type) {
 void Game::TryRepair() {
     // Logic matches ObjectiveTracker.tsx
     // Cost: 3 of relevant material
-    int repairMat = (int)BlockType::Wood;
-    ToolTier current = m_state.player.currentTool;
-    
-    if (current == ToolTier::STONE_PICK) repairMat = (int)BlockType::Stone;
-    else if (current == ToolTier::BRONZE_PICK) repairMat = (int)BlockType::Bronze;
-    else if (current == ToolTier::IRON_PICK) repairMat = (int)BlockType::Iron;
-    else if (current == ToolTier::GOLD_PICK) repairMat = (int)BlockType::Gold;
-    else if (current == ToolTier::DIAMOND_PICK) repairMat = (int)BlockType::Diamond;
+    const OreForged::ToolInfo& tool = OreForged::GetToolInfo(m_state.player.currentTool);
+    const int repairMat = static_cast<int>(tool.repairMaterial);
 
     int cost = 3;
-    if (m_state.inventory[repairMat] >= cost) {
-        m_state.inventory[repairMat] -= cost;
+    if (m_state.inventory.Get(repairMat) >= cost) {
+        m_state.inventory.Add(repairMat, -cost);
         
         m_state.player.isToolBroken = false;
-        // Reset health
-         float maxHealth = 100.0f;
-        if (current == ToolTier::STONE_PICK) maxHealth = 150.0f;
-        if (current == ToolTier::BRONZE_PICK) maxHealth = 250.0f;
-        if (current == ToolTier::IRON_PICK) maxHealth = 500.0f;
-        if (current == ToolTier::GOLD_PICK) maxHealth = 300.0f;
-        if (current == ToolTier::DIAMOND_PICK) maxHealth = 1000.0f;
-        m_state.player.toolHealth = maxHealth;
-
-        PushInventory();
+        m_state.player.toolHealth = tool.maxHealth; // Reset health
+
         PushPlayerStats();
     }
 }
@@ -589,7 +685,6 @@ void Game::UnlockCrafting() {
 }
 
 void Game::TryRegenerate(const std::string& seedStr, bool autoRandomize) {
-    if (m_state.isGenerating) return;
 
     // Parse seed early to check for cheats
     uint32_t seed = 0;
@@ -625,9 +720,6 @@ void Game::TryRegenerate(const std::string& seedStr, bool autoRandomize) {
         return; // Cannot afford
     }
 
-    m_state.isGenerating = true;
-    UpdateFacet("is_generating", "true");
-
     if (autoRandomize) {
         seed = rand() % 90000 + 10000;
         // Notify UI of new seed?
@@ -668,23 +760,77 @@ void Game::TryRegenerate(const std::string& seedStr, bool autoRandomize) {
 
     config.islandFactor = islandFactor;
 
-    // Execution in detached thread to avoid blocking UI
-    std::thread([this, seed, config]() {
-        UpdateFacet("clear_chunks", "true");
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-        
-        m_state.world.Regenerate(seed, config);
-        m_state.world.LoadChunksAroundPosition(0, 0, 2);
-        
-        auto chunks = m_state.world.GetLoadedChunks();
-        for (const auto* chunk : chunks) {
-            std::string chunkData = chunk->Serialize();
-            UpdateFacetJSON("chunk_data", chunkData);
-            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    // A newer request supersedes the build in flight
+    uint64_t generation;
+    std::shared_ptr<std::atomic<bool>> cancel = std::make_shared<std::atomic<bool>>(false);
+    if (m_regenCancel) *m_regenCancel = true;
+    m_regenCancel = cancel;
+    generation = ++m_regenGeneration;
+    m_state.isGenerating = true;
+    UpdateFacet("is_generating", "true");
+    {
+        std::lock_guard<std::mutex> lock(m_regenMutex);
+        m_regenThreads++;
+    }
+
+    // Execution in detached thread to avoid blocking UI. The new world is
+    // built off to the side while the current one stays playable, then
+    // swapped in whole.
+    const bool nativeMeshing = m_state.nativeMeshing;
+    std::thread([this, seed, config, nativeMeshing, generation, cancel]() {
+        PROFILE_THREAD("regen");
+        std::shared_ptr<OreForged::World> built; // Set if the build completed
+        {
+            std::lock_guard<std::mutex> build(m_regenBuildMutex);
+            if (!*cancel) {
+                PROFILE_SCOPE("Regen build");
+                auto staging = std::make_shared<OreForged::World>(seed, CurrentWorld()->GetSharedCache());
+                staging->Regenerate(seed, config);
+                m_chunkAcks.Reset();
+                UpdateFacet("world_staging", std::to_string(generation));
+                
+                // Producer/consumer: generation workers queue chunks as they finish
+                // (nearest to the center first), the sender forwards them as fast as
+                // the UI acknowledges them. The UI keeps them hidden until world_swap.
+                OreForged::BoundedQueue<ChunkPayload> readyChunks(CHUNK_QUEUE_CAPACITY);
+                std::thread sender([this, &readyChunks, &cancel]() {
+                    PROFILE_THREAD("regen sender");
+                    ChunkPayload payload;
+                    while (readyChunks.Pop(payload)) {
+                        if (*cancel) continue; // Drain without sending
+                        m_chunkAcks.Acquire(std::chrono::milliseconds(CHUNK_ACK_TIMEOUT_MS));
+                        UpdateFacetJSON("staged_" + payload.facetId, payload.data);
+                    }
+                });
+                
+                // Meshing runs on the generation workers too
+                const OreForged::World& world = *staging;
+                bool complete = staging->LoadChunksAroundPosition(0, 0, WORLD_CHUNK_RADIUS,
+                    [this, &readyChunks, &world, &cancel, nativeMeshing](const OreForged::Chunk& chunk) {
+                        if (*cancel) return;
+                        readyChunks.Push(EncodeChunk(world, chunk, nativeMeshing));
+                    }, cancel.get());
+                readyChunks.Close();
+                sender.join();
+                
+                if (complete && !*cancel) {
+                    built = std::move(staging);
+                }
+            }
         }
 
-        m_state.isGenerating = false;
-        UpdateFacet("is_generating", "false");
+        // The swap happens on the loop thread, in order with the commands
+        // (no edit straddles it, and the UI sees world_swap after every delta
+        // for the old world)
+        m_scheduler.Post([this, built, generation]() {
+            if (generation != m_regenGeneration) return; // A newer request took over
+            if (built) SwapWorld(built, generation);
+            m_state.isGenerating = false;
+            UpdateFacet("is_generating", "false");
+        });
+
+        std::lock_guard<std::mutex> lock(m_regenMutex);
+        m_regenThreads--; // Last touch of `this`; Run() may return after this
     }).detach();
 
     // Loop ends here, function returns immediately
@@ -700,9 +846,7 @@ void Game::ResetProgression() {
     m_state.progression.damageLevel = 0;
 
     // Reset Inventory
-    for (auto& [key, val] : m_state.inventory) {
-        val = 0;
-    }
+    m_state.inventory.Clear();
 
     // Reset Player
     m_state.player.currentTool = ToolTier::HAND;
@@ -713,8 +857,7 @@ void Game::ResetProgression() {
     m_state.craftingUnlocked = false;
     UpdateFacet("unlock_crafting", "false");
 
-    // Push Updates
-    PushInventory();
+    // Push Updates (inventory goes out with the tick)
     PushPlayerStats();
     PushProgression();
 
@@ -731,16 +874,272 @@ void Game::ToggleWaterCurrency(bool enabled) {
     UpdateFacet("count_water", enabled ? "true" : "false");
 }
 
+void Game::SetNativeMeshing(bool enabled) {
+    if (m_state.nativeMeshing == enabled) return;
+    m_state.nativeMeshing = enabled;
+    UpdateFacet("native_meshing", enabled ? "true" : "false");
+    
+    // A regen in progress already streams in the mode it started with
+    if (m_uiReady && !m_state.isGenerating) {
+        CurrentWorld()->MarkAllDirty();
+    }
+}
+
 // --- STATE PUSHERS ---
 
 void Game::PushInventory() {
+    m_state.inventory.TakeDirty(); // All of it goes out now
     json inv = json::object();
-    for (const auto& [id, count] : m_state.inventory) {
-        inv[std::to_string(id)] = count;
+    const auto& counts = m_state.inventory.Counts();
+    for (std::size_t id = 0; id < counts.size(); id++) {
+        inv[std::to_string(id)] = counts[id];
     }
     UpdateFacetJSON("inventory", inv.dump());
 }
 
+void Game::PushInventoryChanges() {
+    // inventory_patch: just the changed counts, merged into inventory by the UI
+    const uint32_t dirty = m_state.inventory.TakeDirty();
+    if (!dirty) return;
+    std::string patch = "{";
+    const auto& counts = m_state.inventory.Counts();
+    for (std::size_t id = 0; id < counts.size(); id++) {
+        if (!(dirty & (1u << id))) continue;
+        if (patch.size() > 1) patch += ',';
+        patch += '"';
+        patch += std::to_string(id);
+        patch += "\":";
+        patch += std::to_string(counts[id]);
+    }
+    patch += '}';
+    UpdateFacetJSON("inventory_patch", patch);
+}
+
+void Game::PushBlockDelta(int x, int y, int z, int blockTypeId) {
+    // block_updates: flat [x, y, z, type, ...] list, one array per tick
+    UpdateFacetArray("block_updates",
+        std::to_string(x) + "," + std::to_string(y) + "," + std::to_string(z) + "," + std::to_string(blockTypeId));
+}
+
+ChunkPayload Game::EncodeChunk(const OreForged::World& world, const OreForged::Chunk& chunk, bool nativeMeshing) const {
+    PROFILE_SCOPE("Game::EncodeChunk");
+    // Vertex positions are 8-bit; oversized chunks fall back to block IDs
+    if (!nativeMeshing ||
+        chunk.GetSize() > OreForged::MAX_NATIVE_MESH_DIMENSION ||
+        chunk.GetHeight() > OreForged::MAX_NATIVE_MESH_DIMENSION) {
+        return {"chunk_data", chunk.Serialize()};
+    }
+    
+    // Border faces are culled against whatever neighbours are already loaded
+    OreForged::ChunkMeshData mesh = OreForged::BuildChunkMesh(chunk, [&world](int x, int y, int z) {
+        return world.GetBlock(x, y, z).type;
+    });
+    return {"chunk_mesh", OreForged::SerializeChunkMesh(chunk, mesh)};
+}
+
+std::shared_ptr<OreForged::World> Game::CurrentWorld() const {
+    return std::atomic_load(&m_state.world);
+}
+
+void Game::SwapWorld(std::shared_ptr<OreForged::World> world, uint64_t generation) {
+    world->ClearDirty(); // The UI has every chunk already, staged
+    std::atomic_store(&m_state.world, std::move(world));
+    UpdateFacet("world_swap", std::to_string(generation));
+    
+    // Persist the new world next tick (SaveGame replaces the old one's regions)
+    if (m_regions) {
+        m_scheduler.Post([this]() { SaveGame(); });
+    }
+}
+
+bool Game::LoadGame(uint32_t& seed, OreForged::WorldConfig& config) {
+    std::ifstream file(m_saveDir / "level.json");
+    if (!file) return false;
+
+    json level = json::parse(file, nullptr, false);
+    if (level.is_discarded() || !level.is_object() || level.value("version", 0) != SAVE_VERSION) {
+        std::cerr << "Ignoring unreadable save " << (m_saveDir / "level.json") << std::endl;
+        return false;
+    }
+
+    // Parse into locals and apply only once all of it checks out, so a bad
+    // save leaves the default world as it was
+    uint32_t savedSeed;
+    OreForged::WorldConfig savedConfig;
+    std::array<int, OreForged::BLOCK_COUNT> counts{};
+    ProgressionState progression;
+    PlayerState playerState;
+    try {
+        savedSeed = level.at("seed").get<uint32_t>();
+        const json& cfg = level.at("config");
+        savedConfig.size = cfg.at("size");
+        savedConfig.height = cfg.at("height");
+        savedConfig.oreMult = cfg.at("oreMult");
+        savedConfig.treeMult = cfg.at("treeMult");
+        savedConfig.islandFactor = cfg.at("islandFactor");
+        if (!savedConfig.IsValid()) throw std::out_of_range("config out of range");
+
+        for (const auto& [id, count] : level.at("inventory").items()) {
+            const int blockId = std::stoi(id);
+            const int amount = count.get<int>();
+            if (!OreForged::IsValidBlockId(blockId) || amount < 0) throw std::out_of_range("bad inventory entry " + id);
+            counts[blockId] = amount;
+        }
+
+        const json& prog = level.at("progression");
+        progression.treeLevel = prog.at("tree");
+        progression.oreLevel = prog.at("ore");
+        progression.energyLevel = prog.at("energy");
+        progression.damageLevel = prog.at("damage");
+        progression.totalMined = prog.at("totalMined");
+        progression.spentOnCurrentGen = prog.at("spentOnCurrentGen");
+        if (progression.treeLevel < 0 || progression.oreLevel < 0 || progression.energyLevel < 0 ||
+            progression.damageLevel < 0 || progression.totalMined < 0 || progression.spentOnCurrentGen < 0) {
+            throw std::out_of_range("negative progression");
+        }
+
+        const json& player = level.at("player");
+        const int tool = player.at("currentTool");
+        if (tool < static_cast<int>(ToolTier::HAND) || tool > static_cast<int>(ToolTier::DIAMOND_PICK)) {
+            throw std::out_of_range("unknown tool " + std::to_string(tool));
+        }
+        playerState.currentTool = static_cast<ToolTier>(tool);
+        playerState.toolHealth = player.at("toolHealth");
+        playerState.isToolBroken = player.at("isToolBroken");
+        if (!std::isfinite(playerState.toolHealth) || playerState.toolHealth < 0.0f) {
+            throw std::out_of_range("bad tool health");
+        }
+
+        const std::string worldName = level.value("worldName", m_state.worldName);
+        const bool countWater = level.value("countWaterAsCurrency", true);
+        const bool crafting = level.value("craftingUnlocked", false);
+        const bool nativeMeshing = level.value("nativeMeshing", false);
+
+        seed = savedSeed;
+        config = savedConfig;
+        m_state.worldName = worldName;
+        m_state.countWaterAsCurrency = countWater;
+        m_state.craftingUnlocked = crafting;
+        m_state.nativeMeshing = nativeMeshing;
+        for (int id = 0; id < static_cast<int>(OreForged::BLOCK_COUNT); id++) m_state.inventory.Set(id, counts[id]);
+        m_state.progression = progression;
+        m_state.player = playerState;
+    } catch (const std::exception& e) {
+        std::cerr << "Ignoring unreadable save " << (m_saveDir / "level.json") << ": " << e.what() << std::endl;
+        return false;
+    }
+
+    std::cout << "Loaded save from " << m_saveDir << " (seed " << seed << ")" << std::endl;
+    return true;
+}
+
+void Game::SaveGame() {
+    if (!m_regions) return;
+    PROFILE_SCOPE("Game::SaveGame");
+    auto start = std::chrono::steady_clock::now();
+
+    // A regeneration replaced the world since the last save. Its chunks go
+    // to regions stamped with its own seed and config, which replace the old
+    // world's as they are written; a region of the wrong world never loads.
+    // Whatever is left of the old world goes once level.json names the new one.
+    const auto world = CurrentWorld();
+    bool replaced = false;
+    if (world->GetRegionStore() != m_regions) {
+        m_regions = std::make_shared<OreForged::RegionStore>(m_saveDir / "region", world->GetSeed(), world->GetConfig());
+        world->SetRegionStore(m_regions);
+        replaced = true;
+    }
+
+    // Chunks first: level.json names the world they belong to
+    const std::size_t chunks = world->SaveChunks();
+
+    const OreForged::WorldConfig config = world->GetConfig();
+    json inventory = json::object();
+    const auto& counts = m_state.inventory.Counts();
+    for (std::size_t id = 0; id < counts.size(); id++) {
+        inventory[std::to_string(id)] = counts[id];
+    }
+    json level = {
+        {"version", SAVE_VERSION},
+        {"worldName", m_state.worldName},
+        {"seed", world->GetSeed()},
+        {"config", {
+            {"size", config.size},
+            {"height", config.height},
+            {"oreMult", config.oreMult},
+            {"treeMult", config.treeMult},
+            {"islandFactor", config.islandFactor}
+        }},
+        {"countWaterAsCurrency", m_state.countWaterAsCurrency},
+        {"craftingUnlocked", m_state.craftingUnlocked},
+        {"nativeMeshing", m_state.nativeMeshing},
+        {"inventory", inventory},
+        {"progression", {
+            {"tree", m_state.progression.treeLevel},
+            {"ore", m_state.progression.oreLevel},
+            {"energy", m_state.progression.energyLevel},
+            {"damage", m_state.progression.damageLevel},
+            {"totalMined", m_state.progression.totalMined},
+            {"spentOnCurrentGen", m_state.progression.spentOnCurrentGen}
+        }},
+        {"player", {
+            {"currentTool", static_cast<int>(m_state.player.currentTool)},
+            {"toolHealth", m_state.player.toolHealth},
+            {"isToolBroken", m_state.player.isToolBroken}
+        }}
+    };
+
+    // Written aside and renamed over, so a crash mid-save keeps the last one
+    std::error_code error;
+    std::filesystem::create_directories(m_saveDir, error);
+    const std::filesystem::path path = m_saveDir / "level.json";
+    const std::filesystem::path tmpPath = m_saveDir / "level.json.tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        file << level.dump(2);
+        if (!file) {
+            std::cerr << "Failed to write " << tmpPath << std::endl;
+            return;
+        }
+    }
+    if (!OreForged::SyncFile(tmpPath)) {
+        std::cerr << "Failed to write " << tmpPath << std::endl;
+        return;
+    }
+    std::filesystem::rename(tmpPath, path, error);
+    if (error) {
+        std::cerr << "Failed to save " << path << ": " << error.message() << std::endl;
+        return;
+    }
+    if (replaced) {
+        m_regions->RemoveOtherWorlds();
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+    std::cout << "Saved game (" << chunks << " chunks) in " << elapsed.count() << " ms" << std::endl;
+}
+
+void Game::PushDirtyChunks() {
+    if (!m_uiReady) return; // OnUIReady marks everything anyway
+    PROFILE_SCOPE("Game::PushDirtyChunks");
+    const auto world = CurrentWorld();
+    const std::vector<OreForged::ChunkPos> dirty = world->TakeDirtyChunks(0, 0, MAX_CHUNK_SENDS_PER_TICK);
+
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < dirty.size(); i++) {
+        if (bytes >= CHUNK_SEND_BUDGET_BYTES) {
+            // Over budget: the rest wait for the next tick
+            for (; i < dirty.size(); i++) world->MarkDirty(dirty[i].x, dirty[i].z);
+            break;
+        }
+        const auto chunk = world->GetChunk(dirty[i].x, dirty[i].z);
+        if (!chunk) continue;
+        ChunkPayload payload = EncodeChunk(*world, *chunk, m_state.nativeMeshing);
+        bytes += payload.data.size();
+        UpdateFacetJSON(payload.facetId, payload.data);
+    }
+}
+
 void Game::PushPlayerStats() {
     long long regenCost = 0;
     if (m_state.craftingUnlocked) {
@@ -769,24 +1168,77 @@ void Game::PushProgression() {
     UpdateFacetJSON("progression", prog.dump());
 }
 
+void Game::PushTickStats() {
+    // Once a second: how the last second's ticks went
+    const OreForged::TickStats stats = m_scheduler.TakeWindowStats();
+    if (stats.ticks == 0) return;
+
+    if (stats.overruns > 0 || stats.skipped > 0) {
+        std::cout << "Game loop: " << stats.overruns << " tick overruns (worst " << stats.worstUs / 1000.0
+                  << " ms), " << stats.skipped << " ticks skipped in the last second" << std::endl;
+    }
+    if (!m_uiReady) return;
+
+    json tick = {
+        {"ticks", stats.ticks},
+        {"avgMs", stats.busyUs / 1000.0 / stats.ticks},
+        {"worstMs", stats.worstUs / 1000.0},
+        {"overruns", stats.overruns},
+        {"skipped", stats.skipped},
+        {"commands", stats.commands},
+        {"backlogged", stats.backlogged}
+    };
+    UpdateFacetJSON("tick_stats", tick.dump());
+}
+
+void Game::PushPerfStats() {
+    // Once a second: per-scope timings over the last second, all threads
+    const std::vector<OreForged::Profiler::ScopeStats> stats = OreForged::Profiler::TakeWindowStats();
+    if (!m_uiReady || stats.empty()) return;
+
+    json perf = json::object();
+    for (const auto& scope : stats) {
+        perf[scope.name] = {
+            {"count", scope.count},
+            {"p50Us", scope.p50Us},
+            {"p99Us", scope.p99Us},
+            {"maxUs", scope.maxUs},
+            {"totalMs", scope.totalMs}
+        };
+    }
+    UpdateFacetJSON("perf_stats", perf.dump());
+}
+
 float Game::GetDamageMultiplier() {
     return 1.0f + m_state.progression.damageLevel;
 }
 
+// Pushes contend with the regen threads for the batcher, hence the timers
 void Game::UpdateFacet(const std::string& id, const std::string& value) {
-    if (!m_webview) return;
-    m_webview->w.dispatch([=]() {
-        if (!m_webview) return;
-        std::string script = "if(window.OreForged && window.OreForged.updateFacet) window.OreForged.updateFacet('" + id + "', " + value + ");";
-        m_webview->w.eval(script);
-    });
+    PROFILE_SCOPE("Game::UpdateFacet");
+    m_facets.Push(id, value);
 }
 
 void Game::UpdateFacetJSON(const std::string& id, const std::string& jsonValue) {
-    if (!m_webview) return;
-    m_webview->w.dispatch([=]() {
-        if (!m_webview) return;
-        std::string script = "if(window.OreForged && window.OreForged.updateFacet) window.OreForged.updateFacet('" + id + "', " + jsonValue + ");";
-        m_webview->w.eval(script);
-    });
+    PROFILE_SCOPE("Game::UpdateFacet");
+    m_facets.Push(id, jsonValue);
+}
+
+void Game::UpdateFacetArray(const std::string& id, const std::string& elements) {
+    PROFILE_SCOPE("Game::UpdateFacet");
+    m_facets.Append(id, elements);
+}
+
+void Game::FlushFacets() {
+    PROFILE_SCOPE("Game::FlushFacets");
+    std::chrono::steady_clock::time_point oldestPush;
+    std::vector<OreForged::FacetBatcher::Update> updates = m_facets.Take(&oldestPush);
+    if (updates.empty()) return;
+    m_host->PublishFacets(std::move(updates));
+
+#ifdef OREFORGED_PROFILING
+    // How long the oldest update in the batch waited to go out
+    static const int latencyId = OreForged::Profiler::RegisterScope("Facet latency");
+    OreForged::Profiler::Record(latencyId, oldestPush, std::chrono::steady_clock::now());
+#endif
 }
@@ -1,45 +1,86 @@
 #pragma once
 
-struct WebviewWrapper;
-
 #include <string>
+#include <filesystem>
 #include <memory>
 #include <thread>
+#include <array>
 #include <atomic>
-#include <map>
+#include <mutex>
 #include <vector>
+#include "world/BlockRegistry.h"
 #include "world/World.h"
+#include "core/AckWindow.h"
+#include "core/FacetBatcher.h"
+#include "core/TickScheduler.h"
+#include "core/UIHost.h"
 
 // Game Constants
 constexpr long long REGENERATION_COST = 30;
 
-// Game Definitions
-enum class BlockType {
-    Air = 0,
-    Grass = 1,
-    Dirt = 2,
-    Stone = 3,
-    Water = 4,
-    Wood = 5,
-    Leaves = 6,
-    Bedrock = 7,
-    Sand = 8,
-    Coal = 9,
-    Iron = 10,
-    Gold = 11,
-    Diamond = 12,
-    Bronze = 13
-};
+// Game loop: ticks per second, and how much of each tick queued binding
+// commands may use before the rest wait for the next one
+constexpr int TICKS_PER_SECOND = 60;
+constexpr int TICK_COMMAND_BUDGET_US = 4000;
+
+// Chunk streaming: unacknowledged chunk_data sends allowed at once, finished
+// chunks buffered between generation and the sender, and how long a missing
+// ack may stall the sender
+constexpr int MAX_CHUNKS_IN_FLIGHT = 4;
+constexpr std::size_t CHUNK_QUEUE_CAPACITY = 8;
+constexpr int CHUNK_ACK_TIMEOUT_MS = 250;
+
+// Dirty chunks sent per tick: at most this many, and no more once the
+// tick's payloads reach the byte budget (at least one always goes out)
+constexpr std::size_t MAX_CHUNK_SENDS_PER_TICK = 8;
+constexpr std::size_t CHUNK_SEND_BUDGET_BYTES = 512 * 1024;
+
+// Chunks loaded around the origin, for the first world and each regenerated one
+constexpr int WORLD_CHUNK_RADIUS = 2;
+
+// Most mining actions one interactBatch call may carry
+constexpr std::size_t MAX_INTERACT_BATCH = 256;
+
+// Longest ray the raycast binding walks, in blocks
+constexpr float MAX_RAYCAST_DISTANCE = 256.0f;
+
+// Save format version (level.json) and autosave interval (1 minute)
+constexpr int SAVE_VERSION = 1;
+constexpr long long AUTOSAVE_INTERVAL_TICKS = 60 * TICKS_PER_SECOND;
+
+// Game Definitions (see world/BlockRegistry.h)
+using OreForged::BlockType;
+using OreForged::ToolTier;
+
+// Block counts by block ID. Changes are tracked in a bitmask so a tick only
+// pushes the counts that moved.
+class Inventory {
+public:
+    static_assert(OreForged::BLOCK_COUNT <= 32, "dirty mask holds one bit per block type");
 
-enum class ToolTier {
-    HAND = 0,
-    WOOD_PICK = 1,
-    STONE_PICK = 2,
-    BRONZE_PICK = 3,
-    IRON_PICK = 4,
-    GOLD_PICK = 5,
-    DIAMOND_PICK = 6,
-    FURNACE = 4
+    int Get(int id) const { return OreForged::IsValidBlockId(id) ? m_counts[id] : 0; }
+    void Add(int id, int delta) { Set(id, Get(id) + delta); }
+    void Set(int id, int count) {
+        if (!OreForged::IsValidBlockId(id) || m_counts[id] == count) return;
+        m_counts[id] = count;
+        m_dirty |= 1u << id;
+    }
+    void Clear() {
+        for (int id = 0; id < static_cast<int>(OreForged::BLOCK_COUNT); id++) Set(id, 0);
+    }
+
+    const std::array<int, OreForged::BLOCK_COUNT>& Counts() const { return m_counts; }
+
+    // IDs changed since the last call, one bit each
+    uint32_t TakeDirty() {
+        uint32_t dirty = m_dirty;
+        m_dirty = 0;
+        return dirty;
+    }
+
+private:
+    std::array<int, OreForged::BLOCK_COUNT> m_counts{};
+    uint32_t m_dirty = 0;
 };
 
 struct ProgressionState {
@@ -61,37 +102,58 @@ struct GameState {
     std::string worldName = "New World";
     int renderDistance = 12;
     long long tickCount = 0;
-    bool isGenerating = false;
+    std::atomic<bool> isGenerating{false}; // A regen build is in flight
     bool countWaterAsCurrency = true;
     bool craftingUnlocked = false;
+    bool nativeMeshing = false; // Send C++ greedy meshes (chunk_mesh) instead of block IDs
     
     // Core Game Data
-    std::map<int, int> inventory;
+    Inventory inventory;
     ProgressionState progression;
     PlayerState player;
     
-    // Voxel world
-    OreForged::World world{12345}; 
+    // Voxel world. A regen builds its replacement off to the side and swaps
+    // the pointer (std::atomic_load/store; see Game::CurrentWorld)
+    std::shared_ptr<OreForged::World> world = std::make_shared<OreForged::World>(12345);
+};
+
+// A chunk ready to send: facet id plus its serialized value
+struct ChunkPayload {
+    std::string facetId;
+    std::string data;
 };
 
 class Game {
 public:
-    Game();
+    // With a save directory the game resumes from (and saves to) it: level.json
+    // for the game state, region/ for the world's chunks. Without one nothing
+    // is saved.
+    explicit Game(std::unique_ptr<OreForged::UIHost> host, std::filesystem::path saveDir = {});
     ~Game();
 
     void Run();
 
 private:
+    friend struct GameBenchAccess; // bench/GameBench.cpp drives game logic directly
+
     void InitUI();
+    void BindCommand(const std::string& name, OreForged::UIHost::Binding handler);
     void OnUIReady();
     
     void GameLoop();
     void Update();
     void UpdateFacet(const std::string& id, const std::string& value);
     void UpdateFacetJSON(const std::string& id, const std::string& jsonValue);
+    void UpdateFacetArray(const std::string& id, const std::string& elements);
+    void FlushFacets();
 
     // Game Logic Methods
+    bool TryMineBlock(int x, int y, int z, int blockTypeId);
+    // `count` actions of [x, y, z, blockTypeId], flat; stats and meshes are
+    // pushed once for the lot. Returns how many were mined.
+    int TryMineBlocks(const int* actions, std::size_t count);
     void CollectResource(int blockTypeId, int count);
+    bool CreditResource(int blockTypeId, int count); // CollectResource without the pushes
     void TryCraft(const std::string& recipeJson);
     void TryRepair();
     void TryBuyUpgrade(const std::string& type);
@@ -99,17 +161,53 @@ private:
     void UnlockCrafting();
     void ResetProgression();
     void ToggleWaterCurrency(bool enabled);
+    void SetNativeMeshing(bool enabled);
+    
+    // Persistence (game loop thread)
+    bool LoadGame(uint32_t& seed, OreForged::WorldConfig& config);
+    void SaveGame();
 
     // Helpers
-    void PushInventory();
+    void PushBlockDelta(int x, int y, int z, int blockTypeId);
+    ChunkPayload EncodeChunk(const OreForged::World& world, const OreForged::Chunk& chunk, bool nativeMeshing) const;
+    std::shared_ptr<OreForged::World> CurrentWorld() const;
+    void SwapWorld(std::shared_ptr<OreForged::World> world, uint64_t generation);
+    void PushDirtyChunks();
+    void PushInventory();        // Every count
+    void PushInventoryChanges(); // Counts changed since the last push
     void PushPlayerStats();
     void PushProgression();
+    void PushTickStats();
+    void PushPerfStats();
     float GetDamageMultiplier();
 
-    std::unique_ptr<WebviewWrapper> m_webview;
+    std::unique_ptr<OreForged::UIHost> m_host;
+    std::filesystem::path m_saveDir;
+    std::shared_ptr<OreForged::RegionStore> m_regions; // Null when not saving
     
     GameState m_state;
     std::atomic<bool> m_isRunning{false};
     std::atomic<bool> m_uiReady{false};
+    OreForged::AckWindow m_chunkAcks{MAX_CHUNKS_IN_FLIGHT}; // staged_ chunk sends only
+    
+    // Facet updates are buffered and sent once per tick; these carry events
+    // rather than state, so every value is delivered
+    OreForged::FacetBatcher m_facets{"chunk_data", "chunk_mesh", "staged_chunk_data", "staged_chunk_mesh",
+                                     "world_staging", "world_swap", "show_toast"};
     std::thread m_gameLoopThread;
+    
+    // Runs the game loop. Gameplay bindings are queued here as commands, so
+    // the loop thread is the only one that touches m_state.
+    OreForged::TickScheduler m_scheduler{TICKS_PER_SECOND, std::chrono::microseconds(TICK_COMMAND_BUDGET_US)};
+    
+    // Regeneration: each request gets a generation number and a cancel flag
+    // that the next request sets. Builds run one at a time (m_regenBuildMutex);
+    // a cancelled one gives up within a chunk.
+    // Requests and completions run on the loop thread; m_regenMutex only
+    // guards the thread count, which Run() waits on.
+    std::mutex m_regenMutex;
+    uint64_t m_regenGeneration = 0;
+    std::shared_ptr<std::atomic<bool>> m_regenCancel;
+    int m_regenThreads = 0;
+    std::mutex m_regenBuildMutex;
 };
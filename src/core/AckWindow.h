@@ -0,0 +1,44 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+namespace OreForged {
+
+// Credit window for sends that the UI acknowledges.
+// Acquire blocks while `limit` sends are unacknowledged. A lost or missing
+// ack only stalls the sender for `timeout`, after which the send proceeds.
+class AckWindow {
+public:
+    explicit AckWindow(int limit) : m_limit(limit > 0 ? limit : 1) {}
+
+    // Returns false if the wait timed out (the send is still counted)
+    bool Acquire(std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        bool acked = m_available.wait_for(lock, timeout, [&] { return m_inFlight < m_limit; });
+        m_inFlight++;
+        return acked;
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_inFlight > 0) m_inFlight--;
+        m_available.notify_one();
+    }
+
+    // Forget outstanding sends (e.g. the UI reloaded and will never ack them)
+    void Reset() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_inFlight = 0;
+        m_available.notify_all();
+    }
+
+private:
+    int m_limit;
+    int m_inFlight = 0;
+    std::mutex m_mutex;
+    std::condition_variable m_available;
+};
+
+} // namespace OreForged
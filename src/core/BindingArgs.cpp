@@ -0,0 +1,278 @@
+#include "BindingArgs.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <nlohmann/json.hpp>
+#include <string>
+
+using json = nlohmann::json;
+
+namespace OreForged {
+
+namespace {
+    class Reader {
+    public:
+        explicit Reader(std::string_view text) : m_text(text) {}
+
+        void SkipSpace() {
+            while (m_pos < m_text.size() && (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' ||
+                                             m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+                m_pos++;
+            }
+        }
+
+        bool Consume(char c) {
+            SkipSpace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                m_pos++;
+                return true;
+            }
+            return false;
+        }
+
+        char Peek() {
+            SkipSpace();
+            return m_pos < m_text.size() ? m_text[m_pos] : '\0';
+        }
+
+        bool AtEnd() {
+            SkipSpace();
+            return m_pos == m_text.size();
+        }
+
+        // Plain integer: optional '-', then digits, no fraction or exponent.
+        // Leading zeros are turned down, as JSON does.
+        bool ReadInt(int& value) {
+            SkipSpace();
+            const char* first = m_text.data() + m_pos;
+            const char* last = m_text.data() + m_text.size();
+            auto [end, ec] = std::from_chars(first, last, value);
+            if (ec != std::errc() || end == first) return false;
+            if (end < last && (*end == '.' || *end == 'e' || *end == 'E')) return false;
+            const char* digits = *first == '-' ? first + 1 : first;
+            if (*digits == '0' && end - digits > 1) return false;
+            m_pos += static_cast<std::size_t>(end - first);
+            return true;
+        }
+
+        // Contents of a string without escapes
+        bool ReadString(std::string_view& value) {
+            if (!Consume('"')) return false;
+            const std::size_t close = m_text.find('"', m_pos);
+            if (close == std::string_view::npos) return false;
+            value = m_text.substr(m_pos, close - m_pos);
+            if (value.find('\\') != std::string_view::npos) return false;
+            m_pos = close + 1;
+            return true;
+        }
+
+    private:
+        std::string_view m_text;
+        std::size_t m_pos = 0;
+    };
+
+    bool ParseIntString(std::string_view text, int& value) {
+        Reader reader(text);
+        return reader.ReadInt(value) && reader.AtEnd();
+    }
+
+    // Calls `emit` with each element in order until it returns false (which
+    // stops reading there); false on anything malformed before that
+    template <typename Emit>
+    bool ParseArray(std::string_view text, Emit& emit, bool allowEncoded) {
+        Reader reader(text);
+        if (!reader.Consume('[')) return false;
+
+        bool first = true;
+        if (reader.Peek() != ']') {
+            do {
+                int value = 0;
+                if (reader.Peek() == '"') {
+                    std::string_view inner;
+                    if (!reader.ReadString(inner)) return false;
+                    // ["[...]"]: the whole argument list, encoded once more
+                    if (first && allowEncoded && Reader(inner).Peek() == '[') {
+                        return reader.Consume(']') && reader.AtEnd() && ParseArray(inner, emit, false);
+                    }
+                    if (!ParseIntString(inner, value)) return false;
+                } else if (!reader.ReadInt(value)) {
+                    return false;
+                }
+                if (!emit(value)) return true;
+                first = false;
+            } while (reader.Consume(','));
+        }
+        return reader.Consume(']') && reader.AtEnd();
+    }
+}
+
+bool ParseIntArgs(std::string_view req, int* out, std::size_t count) {
+    std::size_t n = 0;
+    auto emit = [&](int value) {
+        if (n < count) out[n] = value;
+        n++;
+        return true;
+    };
+    return ParseArray(req, emit, true) && n >= count;
+}
+
+bool ParseIntList(std::string_view req, std::vector<int>& out, std::size_t maxCount) {
+    out.clear();
+    auto emit = [&](int value) {
+        out.push_back(value);
+        return out.size() <= maxCount;
+    };
+    return ParseArray(req, emit, true);
+}
+
+namespace {
+    // Collects ParseIntListJson's values as the parser produces them, so an
+    // oversized list is only read up to its cap
+    class IntListSax : public json::json_sax_t {
+    public:
+        IntListSax(std::vector<int>& out, std::size_t group, std::size_t maxCount, bool allowEncoded)
+            : m_out(out), m_group(group), m_maxCount(maxCount), m_allowEncoded(allowEncoded) {}
+
+        bool IsArray() const { return m_isArray; }
+        bool IsFull() const { return m_full; }
+
+        bool null() override { return Value(0); }
+        bool boolean(bool) override { return Value(0); }
+        bool binary(json::binary_t&) override { return Value(0); }
+
+        bool number_integer(json::number_integer_t value) override {
+            if (Ignored()) return true;
+            if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) return false;
+            return Value(static_cast<int>(value));
+        }
+
+        bool number_unsigned(json::number_unsigned_t value) override {
+            if (Ignored()) return true;
+            if (value > static_cast<json::number_unsigned_t>(std::numeric_limits<int>::max())) return false;
+            return Value(static_cast<int>(value));
+        }
+
+        // Truncated toward zero, like get<int>
+        bool number_float(json::number_float_t value, const json::string_t&) override {
+            if (Ignored()) return true;
+            const double truncated = std::trunc(value);
+            if (!(truncated >= std::numeric_limits<int>::min() && truncated <= std::numeric_limits<int>::max())) {
+                return false;
+            }
+            return Value(static_cast<int>(truncated));
+        }
+
+        bool string(json::string_t& text) override {
+            if (Ignored()) return true;
+            // ["[...]"]: the whole argument list, encoded once more. It
+            // replaces the outer list; whatever follows is only checked.
+            if (m_depth == 1 && m_first && m_allowEncoded) {
+                std::vector<int> inner;
+                IntListSax sax(inner, m_group, m_maxCount, false);
+                const bool parsed = json::sax_parse(text.begin(), text.end(), &sax);
+                if ((parsed && sax.IsArray()) || sax.IsFull()) {
+                    m_out = std::move(inner);
+                    m_encoded = true;
+                    m_first = false;
+                    m_full = sax.IsFull();
+                    return !m_full;
+                }
+            }
+            int value = 0;
+            try {
+                value = std::stoi(text);
+            } catch (...) {
+                value = 0;
+            }
+            return Value(value);
+        }
+
+        // Objects, and arrays nested deeper than an action, count as one 0
+        bool start_object(std::size_t) override { return Skip(); }
+        bool key(json::string_t&) override { return true; }
+        bool end_object() override {
+            m_skipDepth--;
+            return true;
+        }
+
+        bool start_array(std::size_t) override {
+            if (m_skipDepth > 0 || m_depth >= 2) return Skip();
+            if (m_depth == 0) {
+                m_isArray = true;
+            } else {
+                m_action.clear();
+                m_first = false;
+            }
+            m_depth++;
+            return true;
+        }
+
+        bool end_array() override {
+            if (m_skipDepth > 0) {
+                m_skipDepth--;
+                return true;
+            }
+            m_depth--;
+            // An action: its first `group` values, unless it is too short
+            if (m_depth == 1 && !m_encoded && m_action.size() >= m_group) {
+                for (std::size_t i = 0; i < m_group; i++) {
+                    if (!Push(m_action[i])) return false;
+                }
+            }
+            return true;
+        }
+
+        bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&) override {
+            return false;
+        }
+
+    private:
+        // Inside a skipped container, or after an encoded list
+        bool Ignored() const { return m_skipDepth > 0 || m_encoded; }
+
+        bool Skip() {
+            const bool ok = m_skipDepth > 0 || Value(0);
+            m_skipDepth++;
+            return ok;
+        }
+
+        bool Value(int value) {
+            if (Ignored()) return true;
+            if (m_depth == 0) return false; // Not an array
+            if (m_depth == 2) {
+                m_action.push_back(value);
+                return true;
+            }
+            m_first = false;
+            return Push(value);
+        }
+
+        bool Push(int value) {
+            m_out.push_back(value);
+            m_full = m_out.size() > m_maxCount;
+            return !m_full;
+        }
+
+        std::vector<int>& m_out;
+        std::vector<int> m_action;
+        std::size_t m_group;
+        std::size_t m_maxCount;
+        bool m_allowEncoded;
+
+        int m_depth = 0;
+        int m_skipDepth = 0;
+        bool m_isArray = false;
+        bool m_first = true;
+        bool m_encoded = false;
+        bool m_full = false;
+    };
+}
+
+bool ParseIntListJson(std::string_view req, std::vector<int>& out, std::size_t group, std::size_t maxCount) {
+    out.clear();
+    IntListSax sax(out, group, maxCount, true);
+    return json::sax_parse(req.begin(), req.end(), &sax) || sax.IsFull();
+}
+
+} // namespace OreForged
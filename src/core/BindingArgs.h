@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace OreForged {
+
+// Fast path for bindings whose arguments are a fixed list of integers, e.g.
+// interact's [x, y, z, blockTypeId]. Reads the request in place: no JSON
+// DOM, no allocation, no exceptions.
+//
+// Accepts a JSON array of at least `count` integers (extra elements are
+// ignored), and the variants older UI code sends: the array double-encoded
+// as a string (["[1,2,3,4]"]) and integers sent as strings (["1","2"]).
+// Returns false on anything else (floats, exponents, escapes, too few
+// elements, malformed input), leaving the caller to fall back to a full
+// JSON parse. `out` may be partly written then.
+bool ParseIntArgs(std::string_view req, int* out, std::size_t count);
+
+// Same forms as ParseIntArgs, any length: replaces `out` with every element.
+// Stops reading after maxCount + 1 elements, so a list longer than maxCount
+// comes back as that (and true) without the rest being parsed.
+bool ParseIntList(std::string_view req, std::vector<int>& out, std::size_t maxCount = SIZE_MAX);
+
+// The fallback for when those return false: a full JSON parse, as lenient
+// as the bindings have always been. Takes the same forms plus floats
+// (truncated toward zero) and escaped strings; strings that aren't integers
+// and other values read as 0. Elements that are arrays themselves are
+// actions ([[x, y, z, id], ...]): each adds its first `group` values, or
+// nothing if it is shorter. Returns false if `req` isn't a JSON array or
+// holds a number outside int range. Stops at maxCount like ParseIntList.
+// Wherever ParseIntList succeeds, this yields the same list.
+bool ParseIntListJson(std::string_view req, std::vector<int>& out, std::size_t group = 1,
+                      std::size_t maxCount = SIZE_MAX);
+
+} // namespace OreForged
@@ -0,0 +1,78 @@
+#include "FacetBatcher.h"
+
+namespace OreForged {
+
+FacetBatcher::FacetBatcher(std::initializer_list<std::string> eventFacets)
+    : m_eventFacets(eventFacets) {}
+
+void FacetBatcher::Push(const std::string& id, std::string jsonValue) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.empty()) m_oldestPush = std::chrono::steady_clock::now();
+
+    if (m_eventFacets.count(id) == 0) {
+        auto it = m_slots.find(id);
+        if (it != m_slots.end()) {
+            // Last value wins for state facets
+            m_entries[it->second].value = std::move(jsonValue);
+            return;
+        }
+        m_slots.emplace(id, m_entries.size());
+    }
+
+    m_entries.push_back({id, std::move(jsonValue), false});
+}
+
+void FacetBatcher::Append(const std::string& id, const std::string& elements) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.empty()) m_oldestPush = std::chrono::steady_clock::now();
+
+    auto it = m_slots.find(id);
+    if (it != m_slots.end()) {
+        std::string& value = m_entries[it->second].value;
+        value += ',';
+        value += elements;
+        return;
+    }
+
+    m_slots.emplace(id, m_entries.size());
+    m_entries.push_back({id, elements, true});
+}
+
+std::vector<FacetBatcher::Update> FacetBatcher::Take(std::chrono::steady_clock::time_point* oldestPush) {
+    std::vector<Update> entries;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (oldestPush) *oldestPush = m_oldestPush;
+    entries.swap(m_entries);
+    m_slots.clear();
+    return entries;
+}
+
+std::string FacetBatcher::BuildScript(const std::vector<Update>& entries) {
+    if (entries.empty()) return {};
+
+    static const char PREFIX[] = "if(window.OreForged && window.OreForged.updateFacet){const u=window.OreForged.updateFacet;";
+    static const char SUFFIX[] = "}";
+
+    // Build the script in one allocation
+    std::size_t length = sizeof(PREFIX) + sizeof(SUFFIX);
+    for (const auto& entry : entries) {
+        length += entry.id.size() + entry.value.size() + 10; // u('id',[value]);
+    }
+
+    std::string script;
+    script.reserve(length);
+    script += PREFIX;
+    for (const auto& entry : entries) {
+        script += "u('";
+        script += entry.id;
+        script += "',";
+        if (entry.isArray) script += '[';
+        script += entry.value;
+        if (entry.isArray) script += ']';
+        script += ");";
+    }
+    script += SUFFIX;
+    return script;
+}
+
+} // namespace OreForged
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace OreForged {
+
+// Buffers facet updates between ticks so they reach the UI as one eval.
+//
+// State facets are idempotent: only the last value pushed before a flush is
+// sent, in the slot of the first push. Event facets (chunk payloads, toasts,
+// signals) keep every value in order. Array facets collect the elements
+// appended before a flush into a single JSON array.
+class FacetBatcher {
+public:
+    struct Update {
+        std::string id;
+        std::string value;
+        bool isArray = false; // value holds array elements without brackets
+    };
+
+    explicit FacetBatcher(std::initializer_list<std::string> eventFacets);
+
+    // Thread-safe; `jsonValue` must be a JS/JSON literal
+    void Push(const std::string& id, std::string jsonValue);
+
+    // Thread-safe; `elements` is a comma-separated list of JSON values
+    void Append(const std::string& id, const std::string& elements);
+
+    // Takes everything buffered, in send order. `oldestPush` (if given) is
+    // set to when the first of them was pushed.
+    std::vector<Update> Take(std::chrono::steady_clock::time_point* oldestPush = nullptr);
+
+    // A single script that calls window.OreForged.updateFacet for each update
+    // (empty if there are none)
+    static std::string BuildScript(const std::vector<Update>& updates);
+
+    // Take() + BuildScript()
+    std::string Flush() { return BuildScript(Take()); }
+
+private:
+    std::mutex m_mutex;
+    std::vector<Update> m_entries;
+    std::chrono::steady_clock::time_point m_oldestPush; // Of m_entries, if any
+    std::unordered_map<std::string, std::size_t> m_slots; // State/array facet id -> index in m_entries
+    std::unordered_set<std::string> m_eventFacets;
+};
+
+} // namespace OreForged
@@ -0,0 +1,118 @@
+#include "HeadlessHost.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <nlohmann/json.hpp>
+
+using json = nlohmann::json;
+
+namespace OreForged {
+
+HeadlessHost::HeadlessHost(std::istream& in, std::ostream& out, bool writeFacets)
+    : m_in(in), m_out(out), m_writeFacets(writeFacets) {}
+
+void HeadlessHost::Bind(const std::string& name, Binding binding) {
+    m_bindings[name] = std::move(binding);
+}
+
+void HeadlessHost::Resolve(const std::string& seq, int status, const std::string& result) {
+    if (seq.empty()) return; // Our own chunkAck calls, nobody is waiting
+    WriteLine("{\"id\":" + seq + ",\"status\":" + std::to_string(status) + ",\"result\":" + result + "}");
+}
+
+void HeadlessHost::PublishFacets(std::vector<FacetBatcher::Update> updates) {
+    std::size_t bytes = 0;
+    std::size_t stagedChunks = 0;
+    for (const auto& update : updates) {
+        bytes += update.value.size();
+        if (update.id == "staged_chunk_data" || update.id == "staged_chunk_mesh") {
+            stagedChunks++;
+        }
+    }
+    m_facetUpdates += updates.size();
+    m_facetBytes += bytes;
+
+    // Nothing renders here, so a chunk counts as built once it's published.
+    // Ack staged chunks like the UI would so regeneration isn't held by the
+    // ack timeout (live chunk sends aren't acked).
+    auto ack = m_bindings.find("chunkAck");
+    if (ack != m_bindings.end()) {
+        for (std::size_t i = 0; i < stagedChunks; i++) {
+            ack->second("", "[]");
+        }
+    }
+
+    if (!m_writeFacets) return;
+
+    // Same values the webview would eval, one line each
+    std::string lines;
+    lines.reserve(bytes + updates.size() * 32);
+    for (const auto& update : updates) {
+        lines += "{\"facet\":\"";
+        lines += update.id;
+        lines += "\",\"value\":";
+        if (update.isArray) lines += '[';
+        lines += update.value;
+        if (update.isArray) lines += ']';
+        lines += "}\n";
+    }
+
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    m_out << lines;
+    m_out.flush();
+}
+
+void HeadlessHost::Run() {
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration slept{0};
+
+    std::string line;
+    while (!m_terminated && std::getline(m_in, line)) {
+        if (line.empty()) continue;
+
+        json msg = json::parse(line, nullptr, false);
+        if (msg.is_discarded() || !msg.is_object()) {
+            std::cerr << "Headless: ignoring malformed line: " << line << std::endl;
+            continue;
+        }
+
+        if (msg.contains("sleep") && msg["sleep"].is_number()) {
+            auto duration = std::chrono::milliseconds(msg["sleep"].get<int>());
+            std::this_thread::sleep_for(duration);
+            slept += duration;
+            continue;
+        }
+
+        const std::string seq = msg.contains("id") ? msg["id"].dump() : "null";
+        auto it = m_bindings.end();
+        if (msg.contains("call") && msg["call"].is_string()) {
+            it = m_bindings.find(msg["call"].get<std::string>());
+        }
+        if (it == m_bindings.end()) {
+            Resolve(seq, 1, "\"Unknown binding\"");
+            continue;
+        }
+
+        m_calls++;
+        it->second(seq, msg.contains("args") ? msg["args"].dump() : "[]");
+    }
+
+    // Throughput excludes scripted sleeps
+    const auto busy = std::chrono::steady_clock::now() - start - slept;
+    const double seconds = std::chrono::duration<double>(busy).count();
+    std::cerr << "Headless: " << m_calls << " calls in " << seconds * 1000.0 << " ms ("
+              << (seconds > 0.0 ? m_calls / seconds : 0.0) << " calls/s), "
+              << m_facetUpdates << " facet updates (" << m_facetBytes << " bytes)" << std::endl;
+}
+
+void HeadlessHost::Terminate() {
+    m_terminated = true;
+}
+
+void HeadlessHost::WriteLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(m_outMutex);
+    m_out << line << '\n';
+    m_out.flush();
+}
+
+} // namespace OreForged
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "UIHost.h"
+#include <atomic>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
+#include <unordered_map>
+
+namespace OreForged {
+
+// Scriptable host for load tests and CI boxes: no window, no GPU.
+//
+// Input, one JSON object per line:
+//   {"id": 1, "call": "interact", "args": [0, 9, 0, 1]}   call a binding
+//   {"sleep": 100}                                        pause (ms), lets ticks run
+// Output, one JSON object per line:
+//   {"id": 1, "status": 0, "result": "OK"}                reply to a call
+//   {"facet": "inventory", "value": {...}}                facet update (if enabled)
+//
+// Runs until the input ends or quitApplication is called, then prints a
+// throughput summary to stderr.
+class HeadlessHost : public UIHost {
+public:
+    HeadlessHost(std::istream& in, std::ostream& out, bool writeFacets = true);
+
+    void Bind(const std::string& name, Binding binding) override;
+    void Resolve(const std::string& seq, int status, const std::string& result) override;
+    void PublishFacets(std::vector<FacetBatcher::Update> updates) override;
+    void Run() override;
+    void Terminate() override;
+
+private:
+    void WriteLine(const std::string& line);
+
+    std::istream& m_in;
+    std::ostream& m_out;
+    bool m_writeFacets;
+    std::unordered_map<std::string, Binding> m_bindings;
+
+    std::mutex m_outMutex; // Replies and facets are written from different threads
+    std::atomic<bool> m_terminated{false};
+
+    // Stats for the summary
+    std::size_t m_calls = 0;
+    std::atomic<std::size_t> m_facetUpdates{0};
+    std::atomic<std::size_t> m_facetBytes{0};
+};
+
+} // namespace OreForged
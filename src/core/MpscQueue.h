@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <utility>
+
+namespace OreForged {
+
+// Unbounded lock-free queue: any number of producers, one consumer.
+// Push never blocks (one allocation per item); TryPop is for the consumer
+// thread only. Linked list with a stub node (Vyukov's MPSC queue): a
+// producer swaps itself in as the head, then links the previous head to it.
+template <typename T>
+class MpscQueue {
+public:
+    MpscQueue() : m_head(new Node), m_tail(m_head.load(std::memory_order_relaxed)) {}
+
+    ~MpscQueue() {
+        T discarded;
+        while (TryPop(discarded)) {}
+        delete m_tail;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    void Push(T item) {
+        Node* node = new Node{std::move(item)};
+        Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Returns false if empty. An item whose producer is between its two
+    // steps counts as not there yet.
+    bool TryPop(T& out) {
+        Node* next = m_tail->next.load(std::memory_order_acquire);
+        if (!next) return false;
+        out = std::move(next->value);
+        delete m_tail;
+        m_tail = next; // Becomes the new stub
+        return true;
+    }
+
+private:
+    struct Node {
+        T value{};
+        std::atomic<Node*> next{nullptr};
+    };
+
+    std::atomic<Node*> m_head; // Last pushed
+    Node* m_tail;              // Consumer side: stub, whose next is the oldest item
+};
+
+} // namespace OreForged
@@ -0,0 +1,284 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace OreForged {
+namespace Profiler {
+
+namespace {
+    // Log-linear buckets: values below 8 ns get their own bucket, above that
+    // each power of two is split in 8. Durations are capped at 2^40 ns (~18 min).
+    constexpr int SUB_BITS = 3;
+    constexpr int SUB_BUCKETS = 1 << SUB_BITS;
+    constexpr int MAX_EXPONENT = 40;
+    constexpr int BUCKET_COUNT = (MAX_EXPONENT - SUB_BITS + 2) * SUB_BUCKETS;
+
+    int BucketOf(uint64_t ns) {
+        if (ns < SUB_BUCKETS) return static_cast<int>(ns);
+        int exponent = 63;
+        while (!(ns >> exponent)) exponent--;
+        if (exponent > MAX_EXPONENT) return BUCKET_COUNT - 1;
+        const int sub = static_cast<int>(ns >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1);
+        return (exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    double BucketUpperNs(int bucket) {
+        if (bucket < SUB_BUCKETS) return bucket + 1.0;
+        const int exponent = bucket / SUB_BUCKETS + SUB_BITS - 1;
+        const int sub = bucket % SUB_BUCKETS;
+        return static_cast<double>(static_cast<uint64_t>(SUB_BUCKETS + sub + 1) << (exponent - SUB_BITS));
+    }
+
+    // Written by its thread only (load + store, no read-modify-write),
+    // read by the aggregator
+    struct Histogram {
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> counts{};
+        std::atomic<uint64_t> totalNs{0};
+    };
+
+    struct Counts {
+        std::array<uint64_t, BUCKET_COUNT> counts{};
+        uint64_t totalNs = 0;
+    };
+
+    struct TraceEvent {
+        int scopeId;
+        uint32_t threadId;
+        int64_t startNs; // Since the trace started
+        int64_t durationNs;
+    };
+
+    struct ThreadData {
+        uint32_t id = 0;
+        std::array<std::atomic<Histogram*>, MAX_SCOPES> histograms{};
+        std::mutex traceMutex; // Uncontended except when a trace is collected
+        std::vector<TraceEvent> trace;
+
+        ~ThreadData() {
+            for (auto& histogram : histograms) delete histogram.load();
+        }
+    };
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::string> names;
+        std::unordered_map<std::string, int> ids;
+        std::vector<ThreadData*> threads;
+        uint32_t nextThreadId = 1;
+
+        std::array<Counts, MAX_SCOPES> retired{}; // Threads that have exited
+        std::array<Counts, MAX_SCOPES> lastTaken{};
+
+        // Trace
+        std::atomic<bool> tracing{false};
+        std::atomic<std::size_t> traceEvents{0};
+        std::chrono::steady_clock::time_point traceStart;
+        std::string tracePath;
+        std::vector<TraceEvent> trace; // From exited threads
+        std::unordered_map<uint32_t, std::string> threadNames;
+    };
+
+    Registry& GetRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    // Registers on a thread's first scope; on exit its counts move to the retired totals
+    struct ThreadSlot {
+        ThreadData* data = nullptr;
+
+        ThreadData& Get() {
+            if (!data) {
+                data = new ThreadData;
+                Registry& registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                data->id = registry.nextThreadId++;
+                registry.threads.push_back(data);
+            }
+            return *data;
+        }
+
+        ~ThreadSlot() {
+            if (!data) return;
+            Registry& registry = GetRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            for (int id = 0; id < MAX_SCOPES; id++) {
+                const Histogram* histogram = data->histograms[id].load();
+                if (!histogram) continue;
+                for (int b = 0; b < BUCKET_COUNT; b++) {
+                    registry.retired[id].counts[b] += histogram->counts[b].load(std::memory_order_relaxed);
+                }
+                registry.retired[id].totalNs += histogram->totalNs.load(std::memory_order_relaxed);
+            }
+            registry.trace.insert(registry.trace.end(), data->trace.begin(), data->trace.end());
+            registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), data));
+            delete data;
+        }
+    };
+
+    thread_local ThreadSlot t_thread;
+
+    void Bump(std::atomic<uint64_t>& counter, uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    std::string EscapeJson(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+} // namespace
+
+int RegisterScope(const std::string& name) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    auto it = registry.ids.find(name);
+    if (it != registry.ids.end()) return it->second;
+    if (registry.names.size() >= MAX_SCOPES) return -1;
+
+    const int id = static_cast<int>(registry.names.size());
+    registry.names.push_back(name);
+    registry.ids.emplace(name, id);
+    return id;
+}
+
+void Record(int scopeId, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point end) {
+    if (scopeId < 0 || scopeId >= MAX_SCOPES) return;
+    ThreadData& thread = t_thread.Get();
+
+    Histogram* histogram = thread.histograms[scopeId].load(std::memory_order_relaxed);
+    if (!histogram) {
+        histogram = new Histogram;
+        thread.histograms[scopeId].store(histogram, std::memory_order_release);
+    }
+
+    const auto durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    const uint64_t ns = durationNs > 0 ? static_cast<uint64_t>(durationNs) : 0;
+    Bump(histogram->counts[BucketOf(ns)], 1);
+    Bump(histogram->totalNs, ns);
+
+    Registry& registry = GetRegistry();
+    if (registry.tracing.load(std::memory_order_acquire) &&
+        registry.traceEvents.fetch_add(1, std::memory_order_relaxed) < MAX_TRACE_EVENTS) {
+        const auto sinceStart = std::chrono::duration_cast<std::chrono::nanoseconds>(start - registry.traceStart).count();
+        std::lock_guard<std::mutex> lock(thread.traceMutex);
+        thread.trace.push_back({scopeId, thread.id, sinceStart, static_cast<int64_t>(ns)});
+    }
+}
+
+void SetThreadName(const std::string& name) {
+    ThreadData& thread = t_thread.Get();
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threadNames[thread.id] = name;
+}
+
+std::vector<ScopeStats> TakeWindowStats() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    std::vector<ScopeStats> stats;
+    for (int id = 0; id < static_cast<int>(registry.names.size()); id++) {
+        // Totals only grow (a thread's counts move to `retired` under this
+        // lock), so the window is the difference to the last call
+        Counts total = registry.retired[id];
+        for (ThreadData* thread : registry.threads) {
+            const Histogram* histogram = thread->histograms[id].load(std::memory_order_acquire);
+            if (!histogram) continue;
+            for (int b = 0; b < BUCKET_COUNT; b++) {
+                total.counts[b] += histogram->counts[b].load(std::memory_order_relaxed);
+            }
+            total.totalNs += histogram->totalNs.load(std::memory_order_relaxed);
+        }
+
+        Counts window;
+        uint64_t count = 0;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            window.counts[b] = total.counts[b] - registry.lastTaken[id].counts[b];
+            count += window.counts[b];
+        }
+        window.totalNs = total.totalNs - registry.lastTaken[id].totalNs;
+        registry.lastTaken[id] = total;
+        if (count == 0) continue;
+
+        ScopeStats scope;
+        scope.name = registry.names[id];
+        scope.count = count;
+        scope.totalMs = window.totalNs / 1e6;
+
+        const uint64_t p50Rank = (count + 1) / 2;
+        const uint64_t p99Rank = count - count / 100;
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKET_COUNT; b++) {
+            if (!window.counts[b]) continue;
+            const uint64_t before = seen;
+            seen += window.counts[b];
+            const double upperUs = BucketUpperNs(b) / 1000.0;
+            if (before < p50Rank && seen >= p50Rank) scope.p50Us = upperUs;
+            if (before < p99Rank && seen >= p99Rank) scope.p99Us = upperUs;
+            scope.maxUs = upperUs;
+        }
+        stats.push_back(std::move(scope));
+    }
+    return stats;
+}
+
+void StartTrace(const std::string& path) {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.tracePath = path;
+    registry.traceStart = std::chrono::steady_clock::now();
+    registry.traceEvents = 0;
+    registry.trace.clear();
+    registry.tracing = true;
+}
+
+bool StopTrace() {
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (!registry.tracing) return false;
+    registry.tracing = false;
+
+    std::vector<TraceEvent> events = std::move(registry.trace);
+    registry.trace.clear();
+    for (ThreadData* thread : registry.threads) {
+        std::lock_guard<std::mutex> traceLock(thread->traceMutex);
+        events.insert(events.end(), thread->trace.begin(), thread->trace.end());
+        thread->trace.clear();
+    }
+
+    std::ofstream file(registry.tracePath, std::ios::trunc);
+    file << "{\"traceEvents\":[\n";
+    bool first = true;
+    for (const auto& [threadId, name] : registry.threadNames) {
+        file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadId
+             << ",\"args\":{\"name\":\"" << EscapeJson(name) << "\"}}";
+        first = false;
+    }
+    for (const TraceEvent& event : events) {
+        file << (first ? "" : ",\n") << "{\"name\":\"" << EscapeJson(registry.names[event.scopeId])
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+             << ",\"ts\":" << event.startNs / 1000.0 << ",\"dur\":" << event.durationNs / 1000.0 << "}";
+        first = false;
+    }
+    file << "\n]}\n";
+
+    if (!file) {
+        std::cerr << "Failed to write trace " << registry.tracePath << std::endl;
+        return false;
+    }
+    std::cout << "Wrote " << events.size() << " trace events to " << registry.tracePath << std::endl;
+    return true;
+}
+
+} // namespace Profiler
+} // namespace OreForged
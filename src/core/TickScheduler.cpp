@@ -0,0 +1,100 @@
+#include "TickScheduler.h"
+#include <algorithm>
+#include <thread>
+
+namespace OreForged {
+
+TickScheduler::TickScheduler(int ticksPerSecond, std::chrono::microseconds commandBudget)
+    : m_period(std::chrono::nanoseconds(std::chrono::seconds(1)) / (std::max)(1, ticksPerSecond)),
+      m_commandBudget(commandBudget) {}
+
+void TickScheduler::Post(Task task) {
+    m_commands.Push(std::move(task));
+}
+
+void TickScheduler::Every(long long intervalTicks, Task task) {
+    m_jobs.push_back({(std::max)(1LL, intervalTicks), std::move(task)});
+}
+
+bool TickScheduler::PopCommand(Task& out) {
+    if (m_carried) {
+        out = std::move(m_carried);
+        m_carried = nullptr;
+        return true;
+    }
+    return m_commands.TryPop(out);
+}
+
+bool TickScheduler::RunCommands(std::chrono::steady_clock::time_point deadline) {
+    Task task;
+    while (PopCommand(task)) {
+        task();
+        m_commandsThisTick++;
+        // Checked after running, so every tick makes progress on the queue
+        if (std::chrono::steady_clock::now() >= deadline) {
+            // The queue can't be peeked; hold the next one over to keep the order
+            return !m_commands.TryPop(m_carried);
+        }
+    }
+    return true;
+}
+
+void TickScheduler::Run(const std::atomic<bool>& running, const Task& update) {
+    using clock = std::chrono::steady_clock;
+    auto nextTick = clock::now();
+
+    while (running) {
+        const auto start = clock::now();
+        m_tick++;
+        m_commandsThisTick = 0;
+
+        const bool drained = RunCommands(start + m_commandBudget);
+        for (const Job& job : m_jobs) {
+            if (m_tick % job.interval == 0) job.task();
+        }
+        update();
+
+        const auto end = clock::now();
+        RecordTick(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count(), !drained);
+
+        nextTick += m_period;
+        if (end > nextTick) {
+            // Behind schedule: catch up back to back, or give up on the backlog
+            const long long behind = (end - nextTick) / m_period;
+            if (behind > MAX_CATCH_UP_TICKS) {
+                m_window.skipped += behind;
+                m_total.skipped += behind;
+                nextTick = end;
+            }
+        } else {
+            std::this_thread::sleep_until(nextTick);
+        }
+    }
+}
+
+void TickScheduler::Drain() {
+    Task task;
+    while (PopCommand(task)) {
+        task();
+    }
+}
+
+void TickScheduler::RecordTick(long long workUs, bool backlogged) {
+    const bool overrun = std::chrono::microseconds(workUs) > m_period;
+    for (TickStats* stats : {&m_window, &m_total}) {
+        stats->ticks++;
+        stats->commands += m_commandsThisTick;
+        stats->busyUs += workUs;
+        stats->worstUs = (std::max)(stats->worstUs, workUs);
+        if (overrun) stats->overruns++;
+        if (backlogged) stats->backlogged++;
+    }
+}
+
+TickStats TickScheduler::TakeWindowStats() {
+    TickStats window = m_window;
+    m_window = TickStats{};
+    return window;
+}
+
+} // namespace OreForged
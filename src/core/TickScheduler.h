@@ -0,0 +1,83 @@
+#pragma once
+
+#include "MpscQueue.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <vector>
+
+namespace OreForged {
+
+// Counters for a span of ticks. Times are in microseconds.
+struct TickStats {
+    long long ticks = 0;
+    long long overruns = 0;       // Ticks whose work took longer than the tick period
+    long long skipped = 0;        // Ticks dropped to catch up after falling behind
+    long long commands = 0;       // Commands run
+    long long backlogged = 0;     // Ticks that hit the command budget with commands left
+    long long busyUs = 0;         // Total work time
+    long long worstUs = 0;        // Longest tick
+};
+
+// Fixed-timestep loop for the game thread. Every tick it:
+//   1. runs posted commands, oldest first, until the queue is empty or the
+//      command budget is spent (the rest wait for the next tick),
+//   2. runs the periodic jobs that are due,
+//   3. calls the update function.
+// Other threads only ever Post; everything else runs on the loop thread,
+// which makes it the single writer of whatever the commands touch.
+//
+// A tick that takes longer than the period counts as an overrun. The loop
+// then runs the following ticks back to back; if it falls more than
+// MAX_CATCH_UP_TICKS behind it drops the backlog instead (counted as
+// skipped) so a stall doesn't turn into a burst.
+class TickScheduler {
+public:
+    using Task = std::function<void()>;
+
+    static constexpr int MAX_CATCH_UP_TICKS = 5;
+
+    TickScheduler(int ticksPerSecond, std::chrono::microseconds commandBudget);
+
+    // Any thread. Runs at the start of the next tick (or a later one, if the
+    // budget runs out).
+    void Post(Task task);
+
+    // Runs `task` every `intervalTicks` ticks. Register before Run().
+    void Every(long long intervalTicks, Task task);
+
+    // Ticks until `running` is cleared
+    void Run(const std::atomic<bool>& running, const Task& update);
+
+    // Runs everything still queued, ignoring the budget (the loop has stopped)
+    void Drain();
+
+    // Loop thread only
+    long long GetTick() const { return m_tick; }
+    TickStats TakeWindowStats(); // Since the last call
+    const TickStats& GetTotalStats() const { return m_total; }
+
+private:
+    struct Job {
+        long long interval;
+        Task task;
+    };
+
+    bool PopCommand(Task& out);
+    // Returns false if the budget ran out with commands left
+    bool RunCommands(std::chrono::steady_clock::time_point deadline);
+    void RecordTick(long long workUs, bool backlogged);
+
+    std::chrono::nanoseconds m_period;
+    std::chrono::microseconds m_commandBudget;
+    MpscQueue<Task> m_commands;
+    Task m_carried; // Popped when the budget ran out; runs first next tick
+    std::vector<Job> m_jobs;
+
+    long long m_tick = 0;
+    long long m_commandsThisTick = 0;
+    TickStats m_window;
+    TickStats m_total;
+};
+
+} // namespace OreForged
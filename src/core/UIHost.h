@@ -0,0 +1,34 @@
+#pragma once
+
+#include "FacetBatcher.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OreForged {
+
+// The UI side of the game as Game sees it: named bindings the UI calls,
+// replies to those calls, and facet updates going back. Implemented by the
+// webview window (WebviewHost) and by a scriptable headless host.
+class UIHost {
+public:
+    // `seq` identifies the call for Resolve, `req` is the JSON array of arguments
+    using Binding = std::function<void(const std::string& seq, const std::string& req)>;
+
+    virtual ~UIHost() = default;
+
+    // Register before Run()
+    virtual void Bind(const std::string& name, Binding binding) = 0;
+
+    // Reply to a call; `result` is a JSON literal. Any thread.
+    virtual void Resolve(const std::string& seq, int status, const std::string& result) = 0;
+
+    // Deliver one batch of facet updates. Called from the game loop thread.
+    virtual void PublishFacets(std::vector<FacetBatcher::Update> updates) = 0;
+
+    // Runs on the main thread until Terminate() (or the input ends)
+    virtual void Run() = 0;
+    virtual void Terminate() = 0;
+};
+
+} // namespace OreForged
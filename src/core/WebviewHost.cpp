@@ -0,0 +1,83 @@
+#include "WebviewHost.h"
+#include "webview.h"
+#include <algorithm>
+#include <filesystem>
+#ifdef _WIN32
+  #include <Windows.h>
+#elif __linux__
+  #include <unistd.h>
+  #include <limits.h>
+#elif __APPLE__
+  #include <mach-o/dyld.h>
+#endif
+
+namespace OreForged {
+
+struct WebviewHost::Window {
+    webview::webview w;
+    Window(bool debug) : w(debug, nullptr) {}
+};
+
+WebviewHost::WebviewHost(const std::string& title, int width, int height, bool debug)
+    : m_window(std::make_unique<Window>(debug)) {
+    m_window->w.set_title(title);
+    m_window->w.set_size(width, height, WEBVIEW_HINT_NONE);
+}
+
+WebviewHost::~WebviewHost() = default;
+
+void WebviewHost::Bind(const std::string& name, Binding binding) {
+    m_window->w.bind(name, [binding = std::move(binding)](std::string seq, std::string req, void* /*arg*/) {
+        binding(seq, req);
+    }, nullptr);
+}
+
+void WebviewHost::Resolve(const std::string& seq, int status, const std::string& result) {
+    if (m_closed) return;
+    m_window->w.resolve(seq, status, result); // Dispatches to the UI thread itself
+}
+
+void WebviewHost::PublishFacets(std::vector<FacetBatcher::Update> updates) {
+    if (m_closed) return;
+    std::string script = FacetBatcher::BuildScript(updates);
+    if (script.empty()) return;
+
+    // eval must run on the UI thread
+    m_window->w.dispatch([this, script = std::move(script)]() {
+        m_window->w.eval(script);
+    });
+}
+
+void WebviewHost::Run() {
+    // Portable executable path finding (Load UI)
+    std::filesystem::path exePath;
+#ifdef _WIN32
+    char path[MAX_PATH];
+    GetModuleFileNameA(NULL, path, MAX_PATH);
+    exePath = std::filesystem::path(path);
+#elif __linux__
+    char result[PATH_MAX];
+    ssize_t count = readlink("/proc/self/exe", result, PATH_MAX);
+    exePath = std::filesystem::path(std::string(result, (count > 0) ? count : 0));
+#elif __APPLE__
+    char path[1024];
+    uint32_t size = sizeof(path);
+    if (_NSGetExecutablePath(path, &size) == 0)
+        exePath = std::filesystem::path(path);
+#endif
+
+    auto exeDir = exePath.parent_path();
+    auto htmlPath = exeDir / "ui" / "index.html";
+    std::string htmlPathStr = htmlPath.string();
+    std::replace(htmlPathStr.begin(), htmlPathStr.end(), '\\', '/');
+    m_window->w.navigate("file:///" + htmlPathStr);
+
+    m_window->w.run();
+    m_closed = true;
+}
+
+void WebviewHost::Terminate() {
+    m_window->w.terminate();
+}
+
+} // namespace OreForged
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "UIHost.h"
+#include <atomic>
+#include <memory>
+
+namespace OreForged {
+
+// Desktop window: the React UI in a webview, loaded from ui/index.html next
+// to the executable
+class WebviewHost : public UIHost {
+public:
+    WebviewHost(const std::string& title, int width, int height, bool debug);
+    ~WebviewHost() override;
+
+    void Bind(const std::string& name, Binding binding) override;
+    void Resolve(const std::string& seq, int status, const std::string& result) override;
+    void PublishFacets(std::vector<FacetBatcher::Update> updates) override;
+    void Run() override;
+    void Terminate() override;
+
+private:
+    struct Window; // Keeps webview.h out of this header
+    std::unique_ptr<Window> m_window;
+    std::atomic<bool> m_closed{false}; // Run() returned; nothing left to eval into
+};
+
+} // namespace OreForged
@@ -1,10 +1,69 @@
 #include "Game.h"
+#include "core/HeadlessHost.h"
+#include "core/Profiler.h"
+#ifdef OREFORGED_WITH_GUI
+#include "core/WebviewHost.h"
+#endif
+#include <cstring>
 #include <iostream>
 
-int main() {
+int main(int argc, char** argv) {
+    // --headless: drive the game from JSON lines on stdin (see HeadlessHost.h)
+    // --no-facets: headless, but only count facet updates instead of printing them
+    // --save-dir <dir>: where the game is saved. The window saves to "saves"
+    // by default; headless runs save nothing unless given one.
+    // --trace <file>: record a Chrome trace of the profiled scopes until exit
+#ifdef OREFORGED_WITH_GUI
+    bool headless = false;
+#else
+    bool headless = true; // Built without the webview
+#endif
+    bool writeFacets = true;
+    const char* saveDir = nullptr;
+    const char* traceFile = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        } else if (std::strcmp(argv[i], "--no-facets") == 0) {
+            headless = true;
+            writeFacets = false;
+        } else if (std::strcmp(argv[i], "--save-dir") == 0 && i + 1 < argc) {
+            saveDir = argv[++i];
+        } else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            traceFile = argv[++i];
+        }
+    }
+    if (!saveDir && !headless) {
+        saveDir = "saves";
+    }
+
+    // In headless mode stdout carries only the protocol; game logs go to stderr
+    std::ostream protocolOut(std::cout.rdbuf());
+    if (headless) {
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    PROFILE_THREAD("main");
+    if (traceFile) {
+        OreForged::Profiler::StartTrace(traceFile);
+    }
+
     try {
-        Game game;
+        std::unique_ptr<OreForged::UIHost> host;
+#ifdef OREFORGED_WITH_GUI
+        if (!headless) {
+            host = std::make_unique<OreForged::WebviewHost>("OreForged", 1280, 720, true);
+        }
+#endif
+        if (!host) {
+            host = std::make_unique<OreForged::HeadlessHost>(std::cin, protocolOut, writeFacets);
+        }
+
+        Game game(std::move(host), saveDir ? std::filesystem::path(saveDir) : std::filesystem::path());
         game.Run();
+        if (traceFile) {
+            OreForged::Profiler::StopTrace();
+        }
     } catch (const std::exception& e) {
         std::cerr << "Exception: " << e.what() << std::endl;
         return 1;
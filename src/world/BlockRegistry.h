@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Block.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace OreForged {
+
+constexpr std::size_t BLOCK_COUNT = static_cast<std::size_t>(BlockType::Count);
+
+// Crafted tools; tier numbers match the UI's recipes
+enum class ToolTier : uint8_t {
+    HAND = 0,
+    WOOD_PICK = 1,
+    STONE_PICK = 2,
+    BRONZE_PICK = 3,
+    IRON_PICK = 4,
+    GOLD_PICK = 5,
+    DIAMOND_PICK = 6,
+    FURNACE = 4
+};
+
+struct BlockInfo {
+    const char* name;
+    bool mineable;
+    ToolTier minTool;  // Weakest tool that mines it
+    bool currency;     // Mining it counts toward totalMined (Water only while count_water is on)
+    bool transparent;
+};
+
+struct ToolInfo {
+    BlockType repairMaterial;
+    float maxHealth;
+};
+
+// Per-block properties, indexed by BlockType
+constexpr std::array<BlockInfo, BLOCK_COUNT> BLOCK_INFO = {{
+    {"Air",     false, ToolTier::HAND,        false, true},
+    {"Grass",   true,  ToolTier::HAND,        true,  false},
+    {"Dirt",    true,  ToolTier::HAND,        true,  false},
+    {"Stone",   true,  ToolTier::STONE_PICK,  true,  false},
+    {"Water",   true,  ToolTier::HAND,        true,  true},
+    {"Wood",    true,  ToolTier::HAND,        true,  false},
+    {"Leaves",  true,  ToolTier::HAND,        true,  false},
+    {"Bedrock", false, ToolTier::HAND,        false, false},
+    {"Sand",    true,  ToolTier::HAND,        true,  false},
+    {"Coal",    true,  ToolTier::STONE_PICK,  true,  false},
+    {"Iron",    true,  ToolTier::STONE_PICK,  true,  false},
+    {"Gold",    true,  ToolTier::BRONZE_PICK, true,  false},
+    {"Diamond", true,  ToolTier::IRON_PICK,   true,  false},
+    {"Bronze",  true,  ToolTier::STONE_PICK,  true,  false},
+}};
+
+// Per-tool properties, indexed by ToolTier (HAND through DIAMOND_PICK)
+constexpr std::array<ToolInfo, 7> TOOL_INFO = {{
+    {BlockType::Wood,    100.0f},
+    {BlockType::Wood,    100.0f},
+    {BlockType::Stone,   150.0f},
+    {BlockType::Bronze,  250.0f},
+    {BlockType::Iron,    500.0f},
+    {BlockType::Gold,    300.0f},
+    {BlockType::Diamond, 1000.0f},
+}};
+
+constexpr bool IsValidBlockId(int id) {
+    return id >= 0 && id < static_cast<int>(BLOCK_COUNT);
+}
+
+constexpr const BlockInfo& GetBlockInfo(BlockType type) {
+    return BLOCK_INFO[static_cast<std::size_t>(type)];
+}
+
+// Unknown tiers get the hand's stats
+constexpr const ToolInfo& GetToolInfo(ToolTier tool) {
+    return static_cast<std::size_t>(tool) < TOOL_INFO.size() ? TOOL_INFO[static_cast<std::size_t>(tool)] : TOOL_INFO[0];
+}
+
+constexpr bool CanMine(int blockId, ToolTier tool) {
+    return IsValidBlockId(blockId) && BLOCK_INFO[blockId].mineable && tool >= BLOCK_INFO[blockId].minTool;
+}
+
+static_assert(GetBlockInfo(BlockType::Bronze).minTool == ToolTier::STONE_PICK, "BLOCK_INFO out of order with BlockType");
+static_assert(GetBlockInfo(BlockType::Water).transparent && !GetBlockInfo(BlockType::Stone).transparent,
+              "BLOCK_INFO transparency disagrees with Block::IsTransparent");
+
+} // namespace OreForged
@@ -0,0 +1,295 @@
+#include "BlockStorage.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace OreForged {
+
+namespace {
+    // Index widths are powers of two so an index never straddles two words
+    uint8_t BitsForPalette(std::size_t paletteSize) {
+        if (paletteSize <= 1) return 0;
+        if (paletteSize <= 2) return 1;
+        if (paletteSize <= 4) return 2;
+        if (paletteSize <= 16) return 4;
+        return 8;
+    }
+
+    std::size_t WordsFor(int volume, uint8_t bits) {
+        if (bits == 0) return 0;
+        const int perWord = 64 / bits;
+        return static_cast<std::size_t>((volume + perWord - 1) / perWord);
+    }
+
+    // Free index buffers by word count, up to MAX_BYTES in total. Beyond that
+    // released buffers are simply freed.
+    class WordPool {
+    public:
+        static constexpr std::size_t MAX_BYTES = std::size_t(64) << 20;
+
+        // `count` zeroed words
+        std::vector<uint64_t> Acquire(std::size_t count) {
+            if (count == 0) return {};
+            std::vector<uint64_t> words;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_free.find(count);
+                if (it != m_free.end() && !it->second.empty()) {
+                    words = std::move(it->second.back());
+                    it->second.pop_back();
+                    m_bytes -= count * sizeof(uint64_t);
+                }
+            }
+            if (words.empty()) return std::vector<uint64_t>(count, 0);
+            std::memset(words.data(), 0, count * sizeof(uint64_t));
+            return words;
+        }
+
+        // Takes the buffer out of `words`, leaving it empty
+        void Release(std::vector<uint64_t>& words) {
+            const std::size_t count = words.size();
+            if (count == 0 || words.capacity() != count) {
+                std::vector<uint64_t>().swap(words);
+                return;
+            }
+            std::vector<uint64_t> released;
+            released.swap(words);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_bytes + count * sizeof(uint64_t) > MAX_BYTES) return; // Freed on the way out
+            m_free[count].push_back(std::move(released));
+            m_bytes += count * sizeof(uint64_t);
+        }
+
+        std::size_t Bytes() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_bytes;
+        }
+
+    private:
+        std::mutex m_mutex;
+        std::unordered_map<std::size_t, std::vector<std::vector<uint64_t>>> m_free;
+        std::size_t m_bytes = 0;
+    };
+
+    WordPool& Words() {
+        // Never destroyed: chunks may still be released during static destruction
+        static WordPool* pool = new WordPool();
+        return *pool;
+    }
+
+    // Make `words` hold `count` zeroed words, reusing its buffer when the size matches
+    void ResetWords(std::vector<uint64_t>& words, std::size_t count) {
+        if (words.size() == count) {
+            if (count > 0) std::memset(words.data(), 0, count * sizeof(uint64_t));
+            return;
+        }
+        Words().Release(words);
+        words = Words().Acquire(count);
+    }
+}
+
+BlockStorage::BlockStorage(int size, int height)
+    : m_size(size), m_height(height), m_layerSize(size * size) {
+    int sectionCount = (height + SECTION_HEIGHT - 1) / SECTION_HEIGHT;
+    m_sections.resize(std::max(0, sectionCount));
+}
+
+BlockStorage::BlockStorage(const BlockStorage& other)
+    : m_size(other.m_size), m_height(other.m_height), m_layerSize(other.m_layerSize),
+      m_sections(other.m_sections.size()) {
+    for (std::size_t s = 0; s < m_sections.size(); s++) {
+        const Section& from = other.m_sections[s];
+        Section& to = m_sections[s];
+        to.palette = from.palette;
+        to.bits = from.bits;
+        to.stale = from.stale;
+        to.words = Words().Acquire(from.words.size());
+        if (!from.words.empty()) {
+            std::memcpy(to.words.data(), from.words.data(), from.words.size() * sizeof(uint64_t));
+        }
+    }
+}
+
+BlockStorage::~BlockStorage() {
+    for (Section& section : m_sections) {
+        Words().Release(section.words);
+    }
+}
+
+int BlockStorage::SectionVolume(int sectionIndex) const {
+    int layers = std::min(SECTION_HEIGHT, m_height - sectionIndex * SECTION_HEIGHT);
+    return layers * m_layerSize;
+}
+
+uint32_t BlockStorage::ReadIndex(const Section& section, int i) {
+    const int perWord = 64 / section.bits;
+    const uint64_t word = section.words[i / perWord];
+    const int shift = (i % perWord) * section.bits;
+    return static_cast<uint32_t>((word >> shift) & ((1ull << section.bits) - 1));
+}
+
+void BlockStorage::WriteIndex(Section& section, int i, uint32_t value) {
+    const int perWord = 64 / section.bits;
+    uint64_t& word = section.words[i / perWord];
+    const int shift = (i % perWord) * section.bits;
+    const uint64_t mask = ((1ull << section.bits) - 1) << shift;
+    word = (word & ~mask) | ((static_cast<uint64_t>(value) << shift) & mask);
+}
+
+// Re-encode a section at a new index width, optionally remapping palette indices
+void BlockStorage::Resize(Section& section, int volume, uint8_t bits, const std::vector<uint8_t>* remap) {
+    Section resized;
+    resized.bits = bits;
+    resized.words = Words().Acquire(WordsFor(volume, bits));
+
+    if (bits > 0 && section.bits > 0) {
+        for (int i = 0; i < volume; i++) {
+            uint32_t index = ReadIndex(section, i);
+            WriteIndex(resized, i, remap ? (*remap)[index] : index);
+        }
+    }
+
+    Words().Release(section.words);
+    section.words = std::move(resized.words);
+    section.bits = bits;
+}
+
+BlockType BlockStorage::Get(int x, int y, int z) const {
+    const Section& section = m_sections[y / SECTION_HEIGHT];
+    if (section.bits == 0) {
+        return section.palette[0];
+    }
+    int i = (y % SECTION_HEIGHT) * m_layerSize + z * m_size + x;
+    return section.palette[ReadIndex(section, i)];
+}
+
+void BlockStorage::Set(int x, int y, int z, BlockType type) {
+    const int sectionIndex = y / SECTION_HEIGHT;
+    Section& section = m_sections[sectionIndex];
+    const int i = (y % SECTION_HEIGHT) * m_layerSize + z * m_size + x;
+
+    auto it = std::find(section.palette.begin(), section.palette.end(), type);
+    uint32_t slot = static_cast<uint32_t>(it - section.palette.begin());
+
+    if (it != section.palette.end()) {
+        if (section.bits == 0) return; // Uniform section already holds this type
+        if (ReadIndex(section, i) == slot) return;
+    } else {
+        // New type for this section: grow the palette, widen indices if needed
+        section.palette.push_back(type);
+        uint8_t bits = BitsForPalette(section.palette.size());
+        if (bits != section.bits) {
+            Resize(section, SectionVolume(sectionIndex), bits, nullptr);
+        }
+    }
+
+    WriteIndex(section, i, slot);
+    section.stale = true;
+}
+
+void BlockStorage::Compact() {
+    for (int s = 0; s < static_cast<int>(m_sections.size()); s++) {
+        Section& section = m_sections[s];
+        if (!section.stale) continue;
+        section.stale = false;
+        if (section.bits == 0) continue;
+
+        const int volume = SectionVolume(s);
+
+        // Find which palette entries are still referenced
+        std::vector<uint8_t> used(section.palette.size(), 0);
+        for (int i = 0; i < volume; i++) {
+            used[ReadIndex(section, i)] = 1;
+        }
+
+        std::vector<BlockType> palette;
+        std::vector<uint8_t> remap(section.palette.size(), 0);
+        for (std::size_t p = 0; p < section.palette.size(); p++) {
+            if (used[p]) {
+                remap[p] = static_cast<uint8_t>(palette.size());
+                palette.push_back(section.palette[p]);
+            }
+        }
+
+        uint8_t bits = BitsForPalette(palette.size());
+        if (palette.size() == section.palette.size() && bits == section.bits) continue;
+
+        Resize(section, volume, bits, &remap);
+        section.palette = std::move(palette);
+        section.palette.shrink_to_fit();
+    }
+}
+
+void BlockStorage::CopyTo(uint8_t* out) const {
+    for (int s = 0; s < static_cast<int>(m_sections.size()); s++) {
+        const Section& section = m_sections[s];
+        const int volume = SectionVolume(s);
+        uint8_t* dst = out + static_cast<std::size_t>(s) * SECTION_HEIGHT * m_layerSize;
+
+        if (section.bits == 0) {
+            std::memset(dst, static_cast<int>(section.palette[0]), volume);
+            continue;
+        }
+
+        // Decode word by word
+        const int perWord = 64 / section.bits;
+        const uint64_t mask = (1ull << section.bits) - 1;
+        int i = 0;
+        for (uint64_t word : section.words) {
+            for (int k = 0; k < perWord && i < volume; k++, i++) {
+                dst[i] = static_cast<uint8_t>(section.palette[word & mask]);
+                word >>= section.bits;
+            }
+        }
+    }
+}
+
+void BlockStorage::CopyFrom(const uint8_t* in) {
+    for (int s = 0; s < static_cast<int>(m_sections.size()); s++) {
+        Section& section = m_sections[s];
+        const int volume = SectionVolume(s);
+        const uint8_t* src = in + static_cast<std::size_t>(s) * SECTION_HEIGHT * m_layerSize;
+
+        // Palette in first-seen order
+        uint8_t slotOf[256];
+        std::memset(slotOf, 0xFF, sizeof(slotOf));
+        section.palette.clear();
+        for (int i = 0; i < volume; i++) {
+            if (slotOf[src[i]] == 0xFF) {
+                slotOf[src[i]] = static_cast<uint8_t>(section.palette.size());
+                section.palette.push_back(static_cast<BlockType>(src[i]));
+            }
+        }
+        if (section.palette.empty()) section.palette.push_back(BlockType::Air);
+
+        section.bits = BitsForPalette(section.palette.size());
+        ResetWords(section.words, WordsFor(volume, section.bits));
+        section.stale = false;
+        if (section.bits == 0) continue;
+
+        // Encode word by word
+        const int perWord = 64 / section.bits;
+        int i = 0;
+        for (uint64_t& word : section.words) {
+            for (int k = 0; k < perWord && i < volume; k++, i++) {
+                word |= static_cast<uint64_t>(slotOf[src[i]]) << (k * section.bits);
+            }
+        }
+    }
+}
+
+std::size_t BlockStorage::MemoryUsage() const {
+    std::size_t bytes = m_sections.capacity() * sizeof(Section);
+    for (const Section& section : m_sections) {
+        bytes += section.palette.capacity() * sizeof(BlockType);
+        bytes += section.words.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+}
+
+std::size_t BlockStorage::PooledBytes() {
+    return Words().Bytes();
+}
+
+} // namespace OreForged
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Block.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace OreForged {
+
+// Compressed block storage for a chunk.
+//
+// The chunk is split into horizontal sections of SECTION_HEIGHT layers. Each
+// section keeps a small palette of the block types it contains and a
+// bit-packed array of palette indices (0, 1, 2, 4 or 8 bits per block).
+// A section holding a single type (all Air above the surface, all Stone below
+// it) stores no index data at all.
+//
+// Writes go straight into the packed form. A type missing from the palette
+// widens the section in place; palette entries that are no longer used are
+// only dropped by Compact(), so bursts of edits never repack repeatedly.
+//
+// Packed index buffers are recycled through a process-wide pool keyed by
+// word count. Every chunk of a world has the same dimensions, so chunks built
+// after a regeneration take over the buffers the dropped ones gave back
+// (zeroed with memset) instead of going through the allocator again.
+class BlockStorage {
+public:
+    static constexpr int SECTION_HEIGHT = 16;
+
+    BlockStorage(int size, int height);
+    BlockStorage(const BlockStorage& other);
+    BlockStorage(BlockStorage&&) = default;
+    BlockStorage& operator=(const BlockStorage&) = delete;
+    ~BlockStorage();
+
+    BlockType Get(int x, int y, int z) const;
+    void Set(int x, int y, int z, BlockType type);
+
+    // Repack sections touched since the last compaction with a minimal palette
+    void Compact();
+
+    // Expand to the dense layout (index = y * size * size + z * size + x),
+    // writing size * size * height bytes to `out`
+    void CopyTo(uint8_t* out) const;
+
+    // Inverse of CopyTo: replace every block from the dense layout, packing
+    // each section with a minimal palette. IDs must be valid BlockTypes.
+    void CopyFrom(const uint8_t* in);
+
+    // Heap bytes held by this storage (palettes + packed indices)
+    std::size_t MemoryUsage() const;
+
+    // Bytes of index buffers waiting in the pool for reuse
+    static std::size_t PooledBytes();
+
+private:
+    struct Section {
+        std::vector<BlockType> palette{BlockType::Air};
+        std::vector<uint64_t> words; // Packed palette indices, empty when bits == 0
+        uint8_t bits = 0;
+        bool stale = false;          // Palette may contain unused entries
+    };
+
+    int m_size;
+    int m_height;
+    int m_layerSize; // size * size
+    std::vector<Section> m_sections;
+
+    int SectionVolume(int sectionIndex) const;
+    static uint32_t ReadIndex(const Section& section, int i);
+    static void WriteIndex(Section& section, int i, uint32_t value);
+    static void Resize(Section& section, int volume, uint8_t bits, const std::vector<uint8_t>* remap);
+};
+
+} // namespace OreForged
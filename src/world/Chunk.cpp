@@ -1,4 +1,9 @@
 #include "Chunk.h"
+#include "ChunkCodec.h"
+#include "ChunkPool.h"
+#include "NoiseKernels.h"
+#include "core/Profiler.h"
+#include <cstring>
 #include <iostream>
 #include <random>
 #include <cmath>
@@ -9,28 +14,61 @@
 namespace OreForged {
 
 Chunk::Chunk(int chunkX, int chunkZ, int size, int height) 
-    : m_chunkX(chunkX), m_chunkZ(chunkZ), m_size(size), m_height(height) {
-    // Initialize blocks vector
-    m_blocks.resize(size * height * size);
-    // Default constructor of Block sets type to Air (0)
-}
-
-// Indexing: y * (size*size) + z * size + x
-// Y-outer, Z-middle, X-inner
-int GetIndex(int x, int y, int z, int size) {
-    return y * size * size + z * size + x;
+    : m_chunkX(chunkX), m_chunkZ(chunkZ), m_size(size), m_height(height),
+      m_blocks(size, height),
+      m_surfaceY(static_cast<std::size_t>(size) * size, -1),
+      m_topY(static_cast<std::size_t>(size) * size, -1) {
+    // Storage starts as uniform Air sections
 }
 
 Block Chunk::GetBlock(int x, int y, int z) const {
     if (!IsValidPosition(x, y, z)) {
         return Block(); // Return air
     }
-    return m_blocks[GetIndex(x, y, z, m_size)];
+    return Block{m_blocks.Get(x, y, z)};
 }
 
 void Chunk::SetBlock(int x, int y, int z, BlockType type) {
-    if (IsValidPosition(x, y, z)) {
-        m_blocks[GetIndex(x, y, z, m_size)].type = type;
+    if (!IsValidPosition(x, y, z)) return;
+    m_blocks.Set(x, y, z, type);
+    
+    // Raising a column is O(1); only clearing its top block scans down
+    const std::size_t column = static_cast<std::size_t>(z) * m_size + x;
+    const auto update = [&](int16_t& top, bool (*counts)(BlockType)) {
+        if (counts(type)) {
+            if (y > top) top = static_cast<int16_t>(y);
+        } else if (y == top) {
+            int below = y - 1;
+            while (below >= 0 && !counts(m_blocks.Get(x, below, z))) below--;
+            top = static_cast<int16_t>(below);
+        }
+    };
+    update(m_surfaceY[column], [](BlockType t) { return Block{t}.IsSolid(); });
+    update(m_topY[column], [](BlockType t) { return t != BlockType::Air; });
+}
+
+int Chunk::GetSurfaceY(int x, int z) const {
+    if (x < 0 || x >= m_size || z < 0 || z >= m_size) return -1;
+    return m_surfaceY[static_cast<std::size_t>(z) * m_size + x];
+}
+
+int Chunk::GetTopY(int x, int z) const {
+    if (x < 0 || x >= m_size || z < 0 || z >= m_size) return -1;
+    return m_topY[static_cast<std::size_t>(z) * m_size + x];
+}
+
+void Chunk::BuildHeightmaps(const uint8_t* blocks) {
+    const std::size_t layer = static_cast<std::size_t>(m_size) * m_size;
+    for (std::size_t column = 0; column < layer; column++) {
+        int16_t surface = -1;
+        int16_t top = -1;
+        for (int y = m_height - 1; y >= 0 && surface < 0; y--) {
+            const BlockType type = static_cast<BlockType>(blocks[y * layer + column]);
+            if (top < 0 && type != BlockType::Air) top = static_cast<int16_t>(y);
+            if (Block{type}.IsSolid()) surface = static_cast<int16_t>(y);
+        }
+        m_surfaceY[column] = surface;
+        m_topY[column] = top;
     }
 }
 
@@ -50,29 +88,7 @@ namespace {
     // MAX_HEIGHT depends on m_height now, dynamic
     const float ISLAND_RADIUS = 35.0f;
     
-    // Simple hash-based noise function
-    float noise2D(int x, int z, uint32_t seed) {
-        uint32_t n = seed + x * 374761393 + z * 668265263;
-        n = (n ^ (n >> 13)) * 1274126177;
-        return ((n ^ (n >> 16)) & 0x7fffffff) / 2147483648.0f;
-    }
-    
-    // Smooth noise
-    float smoothNoise(float x, float z, uint32_t seed) {
-        int intX = static_cast<int>(x);
-        int intZ = static_cast<int>(z);
-        float fracX = x - intX;
-        float fracZ = z - intZ;
-        
-        float v1 = noise2D(intX, intZ, seed);
-        float v2 = noise2D(intX + 1, intZ, seed);
-        float v3 = noise2D(intX, intZ + 1, seed);
-        float v4 = noise2D(intX + 1, intZ + 1, seed);
-        
-        float i1 = v1 * (1 - fracX) + v2 * fracX;
-        float i2 = v3 * (1 - fracX) + v4 * fracX;
-        return i1 * (1 - fracZ) + i2 * fracZ;
-    }
+    // noise2D / smoothNoise live in NoiseKernels.h
     
     // Multi-octave
     float multiOctaveNoise(float x, float z, uint32_t seed, int octaves) {
@@ -90,7 +106,8 @@ namespace {
         return total / maxValue;
     }
     // Island radial falloff (for small chunk sizes loaded in 5x5 grids)
-    float getIslandFalloff(int worldX, int worldZ, int chunkSize, float islandFactor) {
+    // largeNoise / mediumNoise: smoothNoise at /8 and /4 (seeds 12345, 13345), batched by the caller
+    float getIslandFalloff(int worldX, int worldZ, int chunkSize, float islandFactor, float largeNoise, float mediumNoise) {
         // For small chunks, we load a 5x5 grid centered at chunk (0,0)
         // Center the island at world coordinates (0, 0) for symmetry
         float centerX = 0.0f;
@@ -104,8 +121,8 @@ namespace {
         float baseRadius = chunkSize * 2.5f * islandFactor;
         
         // Multi-octave noise for organic, natural edges
-        float largeWaves = smoothNoise(worldX / 8.0f, worldZ / 8.0f, 12345) * 0.5f;
-        float mediumWaves = smoothNoise(worldX / 4.0f, worldZ / 4.0f, 12345 + 1000) * 0.3f;
+        float largeWaves = largeNoise * 0.5f;
+        float mediumWaves = mediumNoise * 0.3f;
         float smallWaves = noise2D(worldX / 2, worldZ / 2, 12345 + 2000) * 0.2f;
         
         float shapeNoise = largeWaves + mediumWaves + smallWaves;
@@ -124,8 +141,104 @@ namespace {
         return 1.0f;
     }
     
+    // Inputs of calculateHeight that depend only on the seed and world config,
+    // computed once per chunk instead of once per column
+    struct HeightParams {
+        uint32_t seed;
+        int chunkHeight;
+        int chunkSize;
+        float islandFactor;
+        int oreLevel;
+        
+        // Center boost ellipse (see calculateHeight)
+        float ellipseScaleX, ellipseScaleZ;
+        float islandRadius;
+        float offsetX, offsetZ;
+        float cosA, sinA;
+        
+        // Secondary peak (levels 3-5)
+        bool hasSecondaryPeak;
+        float secOffsetX, secOffsetZ;
+    };
+    
+    HeightParams makeHeightParams(uint32_t seed, int chunkHeight, int chunkSize, float islandFactor, float oreMult) {
+        HeightParams p{};
+        p.seed = seed;
+        p.chunkHeight = chunkHeight;
+        p.chunkSize = chunkSize;
+        p.islandFactor = islandFactor;
+        
+        // oreMult = 1.0 + level * 0.5. So Level = (oreMult - 1.0) * 2.
+        p.oreLevel = static_cast<int>((oreMult - 1.0f) * 2.0f + 0.1f); // +0.1 for float epsilon safety
+        
+        // Use seed-based randomness for consistent variation
+        p.ellipseScaleX = 0.8f + (noise2D(seed, seed + 1111, seed + 2222) * 0.5f + 0.5f) * 0.4f; // 0.8 to 1.2
+        p.ellipseScaleZ = 0.8f + (noise2D(seed + 3333, seed + 4444, seed + 5555) * 0.5f + 0.5f) * 0.4f; // 0.8 to 1.2
+        
+        // Random offset from center (up to 25% of island size)
+        p.islandRadius = chunkSize * 2.5f * islandFactor;
+        p.offsetX = (noise2D(seed + 6666, seed + 7777, seed + 8888) * 2.0f - 1.0f) * p.islandRadius * 0.25f;
+        p.offsetZ = (noise2D(seed + 9999, seed + 1010, seed + 1212) * 2.0f - 1.0f) * p.islandRadius * 0.25f;
+        
+        // Random rotation angle
+        float angle = (noise2D(seed + 1313, seed + 1414, seed + 1515) * 0.5f + 0.5f) * 3.14159f * 2.0f;
+        p.cosA = std::cos(angle);
+        p.sinA = std::sin(angle);
+        
+        // Random secondary peak location (near center), 40% chance
+        float plateauRadius = p.islandRadius * 0.4f;
+        float secondaryChance = noise2D(seed + 2020, seed + 2121, seed + 2222) * 0.5f + 0.5f;
+        p.hasSecondaryPeak = secondaryChance > 0.6f;
+        p.secOffsetX = (noise2D(seed + 3030, seed + 3131, seed) * 2.0f - 1.0f) * plateauRadius * 0.5f;
+        p.secOffsetZ = (noise2D(seed + 4040, seed + 4141, seed) * 2.0f - 1.0f) * plateauRadius * 0.5f;
+        
+        return p;
+    }
+    
+    // smoothNoise samples calculateHeight needs, one entry per column, filled
+    // a whole chunk at a time by SmoothNoiseBatch. Only the fields the config
+    // uses are filled.
+    struct HeightmapNoise {
+        std::vector<float> large, medium, small;    // Terrain octaves
+        std::vector<float> shoreLarge, shoreMedium; // Island edge waves (small chunks)
+        std::vector<float> plate;                   // Tectonic plates (ore level 2+)
+        std::vector<float> plateau, tower;          // Large islands
+    };
+    
+    HeightmapNoise sampleHeightmapNoise(const std::vector<int>& worldX, const std::vector<int>& worldZ, const HeightParams& p) {
+        const int count = static_cast<int>(worldX.size());
+        const uint32_t seed = p.seed;
+        HeightmapNoise noise;
+        
+        auto sample = [&](std::vector<float>& out, float divisor, uint32_t noiseSeed) {
+            out.resize(count);
+            SmoothNoiseBatch(worldX.data(), worldZ.data(), count, divisor, noiseSeed, out.data());
+        };
+        
+        sample(noise.large, 20.0f, seed);
+        sample(noise.medium, 10.0f, seed + 1000);
+        sample(noise.small, 5.0f, seed + 2000);
+        if (p.chunkSize < 23) {
+            sample(noise.shoreLarge, 8.0f, 12345);
+            sample(noise.shoreMedium, 4.0f, 12345 + 1000);
+        }
+        if (p.oreLevel >= 2) {
+            sample(noise.plate, 15.0f, seed + 9999);
+        }
+        if (p.islandFactor > 0.45f) {
+            sample(noise.plateau, 8.0f, seed + 9999);
+            sample(noise.tower, 5.0f, seed + 8888);
+        }
+        return noise;
+    }
+    
     // Global Island Logic
-    int calculateHeight(int worldX, int worldZ, uint32_t seed, int chunkHeight, int chunkSize, int localX, int localZ, float islandFactor, float oreMult) {
+    int calculateHeight(int worldX, int worldZ, const HeightParams& p, const HeightmapNoise& noise, int column) {
+        const uint32_t seed = p.seed;
+        const int chunkHeight = p.chunkHeight;
+        const int chunkSize = p.chunkSize;
+        const float islandFactor = p.islandFactor;
+        
         float islandFalloff = 1.0f;
         
         // For standard worlds (Size 32+), create a LARGE island centered at (16,16)
@@ -149,14 +262,15 @@ namespace {
              }
         }
         else if (chunkSize < 23) {
-            islandFalloff = getIslandFalloff(worldX, worldZ, chunkSize, islandFactor);
+            islandFalloff = getIslandFalloff(worldX, worldZ, chunkSize, islandFactor,
+                                             noise.shoreLarge[column], noise.shoreMedium[column]);
             if (islandFalloff < 0.05f) return SEA_LEVEL - 1;
         }
         
         // Smooth multi-octave noise
-        float largeFeatures = smoothNoise(worldX / 20.0f, worldZ / 20.0f, seed);
-        float mediumFeatures = smoothNoise(worldX / 10.0f, worldZ / 10.0f, seed + 1000) * 0.5f;
-        float smallDetails = smoothNoise(worldX / 5.0f, worldZ / 5.0f, seed + 2000) * 0.25f;
+        float largeFeatures = noise.large[column];
+        float mediumFeatures = noise.medium[column] * 0.5f;
+        float smallDetails = noise.small[column] * 0.25f;
         
         float combinedNoise = largeFeatures + mediumFeatures + smallDetails;
         float maxValue = 1.0f + 0.5f + 0.25f;
@@ -189,7 +303,7 @@ namespace {
         // Ore Influence: Create "Cliff Faces" / tectonic shifts instead of just noise
         // User Request: "smaller amount and only every 2 levels"
         // oreMult = 1.0 + level * 0.5. So Level = (oreMult - 1.0) * 2.
-        int oreLevel = static_cast<int>((oreMult - 1.0f) * 2.0f + 0.1f); // +0.1 for float epsilon safety
+        int oreLevel = p.oreLevel;
         
         if (oreLevel >= 2) {
             // Apply only for every 2 levels (2, 4, 6...)
@@ -197,7 +311,7 @@ namespace {
             int tiers = oreLevel / 2; // Level 2,3->1 tier. Level 4,5->2 tiers.
             
             // Use noise to select "tectonic plates"
-            float plateNoise = smoothNoise(worldX / 15.0f, worldZ / 15.0f, seed + 9999);
+            float plateNoise = noise.plate[column];
             
             // If we are on a "fault line" (rapid change in noise), shift up
             if (plateNoise > 0.6f) {
@@ -221,19 +335,14 @@ namespace {
         
         // Center height boost for small-mid+ islands - creates natural elevation
         if (islandFactor > 0.15f) {
-            // Use seed-based randomness for consistent variation
-            float ellipseScaleX = 0.8f + (noise2D(seed, seed + 1111, seed + 2222) * 0.5f + 0.5f) * 0.4f; // 0.8 to 1.2
-            float ellipseScaleZ = 0.8f + (noise2D(seed + 3333, seed + 4444, seed + 5555) * 0.5f + 0.5f) * 0.4f; // 0.8 to 1.2
-            
-            // Random offset from center (up to 25% of island size)
-            float islandRadius = chunkSize * 2.5f * islandFactor;
-            float offsetX = (noise2D(seed + 6666, seed + 7777, seed + 8888) * 2.0f - 1.0f) * islandRadius * 0.25f;
-            float offsetZ = (noise2D(seed + 9999, seed + 1010, seed + 1212) * 2.0f - 1.0f) * islandRadius * 0.25f;
-            
-            // Random rotation angle
-            float angle = (noise2D(seed + 1313, seed + 1414, seed + 1515) * 0.5f + 0.5f) * 3.14159f * 2.0f;
-            float cosA = std::cos(angle);
-            float sinA = std::sin(angle);
+            // Seed-based ellipse, offset and rotation (see makeHeightParams)
+            const float ellipseScaleX = p.ellipseScaleX;
+            const float ellipseScaleZ = p.ellipseScaleZ;
+            const float islandRadius = p.islandRadius;
+            const float offsetX = p.offsetX;
+            const float offsetZ = p.offsetZ;
+            const float cosA = p.cosA;
+            const float sinA = p.sinA;
             
             // Transform world coords to plateau-local coords
             float dx = worldX - offsetX;
@@ -265,14 +374,9 @@ namespace {
                 
                 // Add occasional secondary "mini island on top" for levels 3-5
                 if (islandFactor >= 0.24f && islandFactor <= 0.39f) {
-                    float secondaryChance = noise2D(seed + 2020, seed + 2121, seed + 2222) * 0.5f + 0.5f;
-                    if (secondaryChance > 0.6f) { // 40% chance
-                        // Random secondary peak location (near center)
-                        float secOffsetX = (noise2D(seed + 3030, seed + 3131, seed) * 2.0f - 1.0f) * plateauRadius * 0.5f;
-                        float secOffsetZ = (noise2D(seed + 4040, seed + 4141, seed) * 2.0f - 1.0f) * plateauRadius * 0.5f;
-                        
-                        float secDx = worldX - (offsetX + secOffsetX);
-                        float secDz = worldZ - (offsetZ + secOffsetZ);
+                    if (p.hasSecondaryPeak) { // 40% chance
+                        float secDx = worldX - (offsetX + p.secOffsetX);
+                        float secDz = worldZ - (offsetZ + p.secOffsetZ);
                         float secDist = std::sqrt(secDx * secDx + secDz * secDz);
                         
                         // Small secondary peak
@@ -298,7 +402,7 @@ namespace {
         
         // Add plateaus on larger islands (level 6+) for flat areas
         if (islandFactor > 0.45f) {
-            float plateauNoise = smoothNoise(worldX / 8.0f, worldZ / 8.0f, seed + 9999);
+            float plateauNoise = noise.plateau[column];
             // Create flat areas in broader zones (expanded from 0.6-0.8 to 0.55-0.85)
             if (plateauNoise > 0.55f && plateauNoise < 0.85f) {
                 // Flatten to a moderate height
@@ -312,7 +416,7 @@ namespace {
         
         // Towers on mid-large islands
         if (islandFactor > 0.45f) {
-            float towerNoise = smoothNoise(worldX / 5.0f, worldZ / 5.0f, seed + 8888);
+            float towerNoise = noise.tower[column];
             if (towerNoise > 0.88f) { 
                 float towerH = (towerNoise - 0.88f) * 18.0f * varianceScale * islandFactor;
                 height += static_cast<int>(towerH);
@@ -344,19 +448,45 @@ namespace {
     }
 }
 
-void Chunk::Generate(uint32_t seed, float oreMult, float treeMult, float islandFactor) {
+void Chunk::Generate(uint32_t seed, float oreMult, float treeMult, float islandFactor,
+                     std::vector<SpilledBlock>* spill) {
+    PROFILE_SCOPE("Chunk::Generate");
+    GenerateTerrain(seed, oreMult, islandFactor);
+    GenerateOres(seed, oreMult);
+    GenerateTrees(seed, treeMult, spill);
+    
+    // Ores and trees overwrite terrain; drop palette entries they orphaned
+    m_blocks.Compact();
+}
+
+void Chunk::GenerateTerrain(uint32_t seed, float oreMult, float islandFactor) {
+    PROFILE_SCOPE("Chunk::GenerateTerrain");
     // Determine effective max height (leave 1 block for trees/player?)
     const int GEN_MAX_HEIGHT = std::min(30, m_height - 1); 
 
+    // World coordinates of every column, in the order the fill loop visits them
+    const int columnCount = m_size * m_size;
+    std::vector<int> columnX(columnCount), columnZ(columnCount);
     for (int x = 0; x < m_size; x++) {
         for (int z = 0; z < m_size; z++) {
-            int worldX = m_chunkX * m_size + x; // Use m_size for coordinate projection
-            int worldZ = m_chunkZ * m_size + z;
-            
             // Note: If size changes, the world coordinates scale differently if we use 
             // chunkX * size. This matches "Smaller Levels" visually.
+            columnX[x * m_size + z] = m_chunkX * m_size + x; // Use m_size for coordinate projection
+            columnZ[x * m_size + z] = m_chunkZ * m_size + z;
+        }
+    }
+    
+    // Heightmap: seed constants once, the per-column noise in batches
+    const HeightParams params = makeHeightParams(seed, m_height, m_size, islandFactor, oreMult);
+    const HeightmapNoise noise = sampleHeightmapNoise(columnX, columnZ, params);
+
+    for (int x = 0; x < m_size; x++) {
+        for (int z = 0; z < m_size; z++) {
+            const int column = x * m_size + z;
+            int worldX = columnX[column];
+            int worldZ = columnZ[column];
             
-            int height = calculateHeight(worldX, worldZ, seed, m_height, m_size, x, z, islandFactor, oreMult);
+            int height = calculateHeight(worldX, worldZ, params, noise, column);
             height = std::min(height, GEN_MAX_HEIGHT);
 
             bool isSand = shouldBeSand(worldX, worldZ, height, seed);
@@ -405,12 +535,10 @@ void Chunk::Generate(uint32_t seed, float oreMult, float treeMult, float islandF
             }
         }
     }
-    
-    GenerateOres(seed, oreMult);
-    GenerateTrees(seed, treeMult);
 }
 
 void Chunk::GenerateOres(uint32_t seed, float oreMult) {
+    PROFILE_SCOPE("Chunk::GenerateOres");
     // Track counts for guarantees
     int coalCount = 0, ironCount = 0, bronzeCount = 0, goldCount = 0, diamondCount = 0;
     
@@ -422,7 +550,7 @@ void Chunk::GenerateOres(uint32_t seed, float oreMult) {
     // Natural generation pass
     for (int x = 0; x < m_size; x++) {
         for (int z = 0; z < m_size; z++) {
-            int surfaceY = FindSurfaceY(x, z);
+            int surfaceY = GetSurfaceY(x, z);
             if (surfaceY < 0 || GetBlock(x, surfaceY, z).type != BlockType::Grass) continue;
             if (surfaceY + 1 >= m_height) continue;
             
@@ -481,7 +609,7 @@ void Chunk::GenerateOres(uint32_t seed, float oreMult) {
                 rx = std::max(0, std::min(m_size - 1, rx));
                 rz = std::max(0, std::min(m_size - 1, rz));
                 
-                int sy = FindSurfaceY(rx, rz);
+                int sy = GetSurfaceY(rx, rz);
                 
                 // Only place on land?
                 if (sy < SEA_LEVEL) continue; // Prevent underwater ores
@@ -510,13 +638,14 @@ void Chunk::GenerateOres(uint32_t seed, float oreMult) {
     }
 }
 
-void Chunk::GenerateTrees(uint32_t seed, float treeMult) {
+void Chunk::GenerateTrees(uint32_t seed, float treeMult, std::vector<SpilledBlock>* spill) {
+    PROFILE_SCOPE("Chunk::GenerateTrees");
     int treeCount = 0;
     
     // Natural tree spawning across all chunks
     for (int x = 0; x < m_size; x++) {
         for (int z = 0; z < m_size; z++) {
-            int surfaceY = FindSurfaceY(x, z);
+            int surfaceY = GetSurfaceY(x, z);
             if (surfaceY < SEA_LEVEL || GetBlock(x, surfaceY, z).type != BlockType::Grass) continue;
             
             int worldX = m_chunkX * m_size + x;
@@ -532,7 +661,7 @@ void Chunk::GenerateTrees(uint32_t seed, float treeMult) {
                 else if (heightNoise < 0.30f) trunkHeight = 2;
                 
                 if (surfaceY + trunkHeight + 3 < m_height) {
-                    PlaceTree(x, surfaceY + 1, z, trunkHeight);
+                    PlaceTree(x, surfaceY + 1, z, trunkHeight, spill);
                     treeCount++;
                 }
             }
@@ -560,11 +689,11 @@ void Chunk::GenerateTrees(uint32_t seed, float treeMult) {
                 int rx = 1 + static_cast<int>((noise2D(i * 10, attempt, chunkSeed + 8000) * 0.5f + 0.5f) * (m_size - 2));
                 int rz = 1 + static_cast<int>((noise2D(attempt, i * 10, chunkSeed + 8001) * 0.5f + 0.5f) * (m_size - 2));
                 
-                int sy = FindSurfaceY(rx, rz);
+                int sy = GetSurfaceY(rx, rz);
                 
                 if (sy >= SEA_LEVEL && sy >= 0 && sy + 6 + bonusHeight < m_height) {
                     if (GetBlock(rx, sy, rz).type == BlockType::Grass) {
-                        PlaceTree(rx, sy + 1, rz, 3 + bonusHeight);
+                        PlaceTree(rx, sy + 1, rz, 3 + bonusHeight, spill);
                         treeCount++;
                         placed = true;
                         break;
@@ -590,7 +719,7 @@ void Chunk::GenerateTrees(uint32_t seed, float treeMult) {
             
             // Only place if the island center is in this chunk
             if (localX >= 0 && localX < m_size && localZ >= 0 && localZ < m_size) {
-                int centerY = FindSurfaceY(localX, localZ);
+                int centerY = GetSurfaceY(localX, localZ);
                 
                 // EMERGENCY: Force place tree at island center, ignore all conditions
                 if (centerY < 0) centerY = SEA_LEVEL + 1; // Fallback to safe height
@@ -604,14 +733,14 @@ void Chunk::GenerateTrees(uint32_t seed, float treeMult) {
                 SetBlock(localX, centerY, localZ, BlockType::Grass);
                 
                 // FORCE PLACE TREE - no conditions
-                PlaceTree(localX, centerY + 1, localZ, 3);
+                PlaceTree(localX, centerY + 1, localZ, 3, spill);
                 treeCount = 1;
             }
         }
     }
 }
 
-void Chunk::PlaceTree(int x, int baseY, int z, int trunkHeight) {
+void Chunk::PlaceTree(int x, int baseY, int z, int trunkHeight, std::vector<SpilledBlock>* spill) {
     for (int y = 0; y < trunkHeight; y++) {
         SetBlock(x, baseY + y, z, BlockType::Wood);
     }
@@ -622,50 +751,102 @@ void Chunk::PlaceTree(int x, int baseY, int z, int trunkHeight) {
     for (int dx = -1; dx <= 1; dx++) {
         for (int dz = -1; dz <= 1; dz++) {
             if (dx == 0 && dz == 0) continue;
-            int ly = topY - 1;
-            if (IsValidPosition(x + dx, ly, z + dz)) {
-                if (GetBlock(x+dx,ly,z+dz).type == BlockType::Air) SetBlock(x+dx,ly,z+dz, BlockType::Leaves);
-            }
+            PlaceLeaves(x + dx, topY - 1, z + dz, spill);
         }
     }
     // Top Layer
     for (int dx = -1; dx <= 1; dx++) {
         for (int dz = -1; dz <= 1; dz++) {
-            if (IsValidPosition(x + dx, topY, z + dz)) {
-                 if (GetBlock(x+dx,topY,z+dz).type == BlockType::Air) SetBlock(x+dx,topY,z+dz, BlockType::Leaves);
-            }
+            PlaceLeaves(x + dx, topY, z + dz, spill);
         }
     }
     // Top
     if (IsValidPosition(x, topY+1, z)) SetBlock(x, topY+1, z, BlockType::Leaves);
 }
 
-int Chunk::FindSurfaceY(int x, int z) const {
-    for (int y = m_height - 1; y >= 0; y--) {
-        Block b = GetBlock(x, y, z);
-        if (b.type != BlockType::Air && b.type != BlockType::Water) return y;
+void Chunk::PlaceLeaves(int x, int y, int z, std::vector<SpilledBlock>* spill) {
+    if (y < 0 || y >= m_height) return;
+    if (IsValidPosition(x, y, z)) {
+        if (GetBlock(x, y, z).type == BlockType::Air) SetBlock(x, y, z, BlockType::Leaves);
+    } else if (spill) {
+        spill->push_back({m_chunkX * m_size + x, y, m_chunkZ * m_size + z, BlockType::Leaves});
     }
-    return -1;
 }
 
-std::string Chunk::Serialize() const {
-    std::string json = "{";
-    json += "\"chunkX\":" + std::to_string(m_chunkX) + ",";
-    json += "\"chunkZ\":" + std::to_string(m_chunkZ) + ",";
-    json += "\"size\":" + std::to_string(m_size) + ",";
-    json += "\"height\":" + std::to_string(m_height) + ",";
-    json += "\"blocks\":[";
+void Chunk::ApplySpill(const std::vector<SpilledBlock>& spill) {
+    const int originX = m_chunkX * m_size;
+    const int originZ = m_chunkZ * m_size;
+    for (const SpilledBlock& block : spill) {
+        const int x = block.x - originX;
+        const int z = block.z - originZ;
+        if (IsValidPosition(x, block.y, z) && GetBlock(x, block.y, z).type == BlockType::Air) {
+            SetBlock(x, block.y, z, block.type);
+        }
+    }
+}
+
+std::vector<uint8_t> Chunk::SerializeBinary() const {
+    PROFILE_SCOPE("Chunk::SerializeBinary");
+    const std::size_t blockCount = static_cast<std::size_t>(m_size) * m_size * m_height;
+    std::vector<uint8_t> out(CHUNK_WIRE_HEADER_SIZE + blockCount);
+    uint8_t* p = out.data();
+    
+    // Header
+    p[0] = CHUNK_WIRE_MAGIC[0];
+    p[1] = CHUNK_WIRE_MAGIC[1];
+    p[2] = CHUNK_WIRE_MAGIC[2];
+    p[3] = CHUNK_WIRE_MAGIC[3];
+    p[4] = CHUNK_WIRE_VERSION;
+    p[5] = 0;
+    WriteU16LE(p + 6, static_cast<uint16_t>(m_size));
+    WriteU16LE(p + 8, static_cast<uint16_t>(m_height));
+    WriteU16LE(p + 10, 0);
+    WriteU32LE(p + 12, static_cast<uint32_t>(m_chunkX));
+    WriteU32LE(p + 16, static_cast<uint32_t>(m_chunkZ));
     
-    // Flatten 3D array to 1D: index = y * size * size + z * size + x
-    // Our vector is already in this order!
-    bool first = true;
-    for (const auto& block : m_blocks) {
-        if (!first) json += ",";
-        json += std::to_string(static_cast<int>(block.type));
-        first = false;
+    // Blocks: expanded from the palette storage straight into wire order
+    m_blocks.CopyTo(p + CHUNK_WIRE_HEADER_SIZE);
+    
+    return out;
+}
+
+std::shared_ptr<Chunk> Chunk::DeserializeBinary(const uint8_t* data, std::size_t length) {
+    if (length < CHUNK_WIRE_HEADER_SIZE ||
+        std::memcmp(data, CHUNK_WIRE_MAGIC, sizeof(CHUNK_WIRE_MAGIC)) != 0 ||
+        data[4] != CHUNK_WIRE_VERSION) {
+        return nullptr;
+    }
+    
+    const int size = ReadU16LE(data + 6);
+    const int height = ReadU16LE(data + 8);
+    const std::size_t blockCount = static_cast<std::size_t>(size) * size * height;
+    if (size == 0 || height == 0 || length != CHUNK_WIRE_HEADER_SIZE + blockCount) {
+        return nullptr;
+    }
+    
+    const uint8_t* blocks = data + CHUNK_WIRE_HEADER_SIZE;
+    for (std::size_t i = 0; i < blockCount; i++) {
+        if (blocks[i] >= static_cast<uint8_t>(BlockType::Count)) return nullptr;
     }
     
-    json += "]}";
+    const int chunkX = static_cast<int32_t>(ReadU32LE(data + 12));
+    const int chunkZ = static_cast<int32_t>(ReadU32LE(data + 16));
+    auto chunk = MakePooledChunk(chunkX, chunkZ, size, height);
+    chunk->m_blocks.CopyFrom(blocks);
+    chunk->BuildHeightmaps(blocks);
+    return chunk;
+}
+
+std::string Chunk::Serialize() const {
+    PROFILE_SCOPE("Chunk::Serialize");
+    std::vector<uint8_t> binary = SerializeBinary();
+    
+    // Quoted base64 string, reserved once at its exact length
+    std::string json;
+    json.reserve(Base64EncodedSize(binary.size()) + 2);
+    json += '"';
+    AppendBase64(json, binary.data(), binary.size());
+    json += '"';
     return json;
 }
 
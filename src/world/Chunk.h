@@ -1,8 +1,10 @@
 #pragma once
 
 #include "Block.h"
+#include "BlockStorage.h"
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -23,36 +25,78 @@ public:
     
     int GetSize() const { return m_size; }
     int GetHeight() const { return m_height; }
+    
+    // Column heightmaps, kept current by SetBlock: y of the topmost solid
+    // block (not Air or Water) and of the topmost non-Air block, or -1 for
+    // an empty column or a position outside the chunk
+    int GetSurfaceY(int x, int z) const;
+    int GetTopY(int x, int z) const;
 
+    // A block that decoration placed outside the chunk, in world coordinates
+    struct SpilledBlock {
+        int x, y, z;
+        BlockType type;
+    };
+    
     // Generate chunk terrain
     // Config: oreMultiplier, treeMultiplier, islandFactor
-    void Generate(uint32_t seed, float oreMult = 1.0f, float treeMult = 1.0f, float islandFactor = 1.0f);
+    // Features reaching past the chunk's edges (tree leaves) are appended to
+    // `spill` if given, cut off otherwise. World hands them to the neighbours.
+    void Generate(uint32_t seed, float oreMult = 1.0f, float treeMult = 1.0f, float islandFactor = 1.0f,
+                  std::vector<SpilledBlock>* spill = nullptr);
+    
+    // The phases Generate runs, in order (exposed for benchmarks)
+    void GenerateTerrain(uint32_t seed, float oreMult, float islandFactor);
+    void GenerateOres(uint32_t seed, float oreMult);
+    void GenerateTrees(uint32_t seed, float treeMult, std::vector<SpilledBlock>* spill = nullptr);
+    
+    // Places the spilled blocks that fall inside this chunk, only into Air.
+    // The order several spills are applied in doesn't matter.
+    void ApplySpill(const std::vector<SpilledBlock>& spill);
+    
+    // Dense block IDs in wire order (size * size * height bytes)
+    void CopyBlocks(uint8_t* out) const { m_blocks.CopyTo(out); }
     
-    // Serialize chunk data for sending to UI
+    // Binary wire format (see ChunkCodec.h)
+    std::vector<uint8_t> SerializeBinary() const;
+    
+    // Inverse of SerializeBinary; null if the data is not a valid chunk
+    static std::shared_ptr<Chunk> DeserializeBinary(const uint8_t* data, std::size_t length);
+
+    // Serialize chunk data for sending to UI: base64 of the binary format,
+    // already quoted as a JSON string literal for UpdateFacetJSON
     std::string Serialize() const;
     
-    // Check if chunk needs mesh rebuild
-    bool IsDirty() const { return m_dirty; }
-    void SetDirty(bool dirty) { m_dirty = dirty; }
+    // Drop unused palette entries left behind by edits (see BlockStorage)
+    void Compact() { m_blocks.Compact(); }
+    
+    // Resident heap bytes used by block data and heightmaps
+    std::size_t MemoryUsage() const {
+        return m_blocks.MemoryUsage() + (m_surfaceY.capacity() + m_topY.capacity()) * sizeof(int16_t);
+    }
     
 private:
     int m_chunkX;
     int m_chunkZ;
     int m_size;
     int m_height;
-    bool m_dirty = true;
     
-    // Flat array of blocks: index = y * size * size + z * size + x
-    std::vector<Block> m_blocks;
+    // Palette-compressed blocks, logically indexed y * size * size + z * size + x
+    BlockStorage m_blocks;
+    
+    // Heightmaps behind GetSurfaceY / GetTopY, indexed z * size + x
+    std::vector<int16_t> m_surfaceY;
+    std::vector<int16_t> m_topY;
     
     // Helper for array bounds checking
     bool IsValidPosition(int x, int y, int z) const;
     
+    // Rebuild both heightmaps from dense blocks (the CopyBlocks layout)
+    void BuildHeightmaps(const uint8_t* blocks);
+    
     // Generation helpers
-    void GenerateOres(uint32_t seed, float oreMult);
-    void GenerateTrees(uint32_t seed, float treeMult);
-    void PlaceTree(int x, int baseY, int z, int trunkHeight);
-    int FindSurfaceY(int x, int z) const;
+    void PlaceTree(int x, int baseY, int z, int trunkHeight, std::vector<SpilledBlock>* spill);
+    void PlaceLeaves(int x, int y, int z, std::vector<SpilledBlock>* spill);
 };
 
 } // namespace OreForged
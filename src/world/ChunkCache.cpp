@@ -0,0 +1,155 @@
+#include "ChunkCache.h"
+#include <cstring>
+
+namespace OreForged {
+
+namespace {
+    // 64-bit FNV-1a over the raw bytes of each field
+    class KeyHasher {
+    public:
+        template <typename T>
+        void Add(const T& value) {
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            for (unsigned char b : bytes) {
+                m_hash = (m_hash ^ b) * 1099511628211ull;
+            }
+        }
+
+        std::size_t Get() const { return static_cast<std::size_t>(m_hash); }
+
+    private:
+        uint64_t m_hash = 14695981039346656037ull;
+    };
+
+    // What an entry costs: chunk object plus its block storage
+    std::size_t EntryBytes(const Chunk& chunk) {
+        return sizeof(Chunk) + chunk.MemoryUsage();
+    }
+
+    std::size_t EntryBytes(const ChunkCache::Spill& spill) {
+        return sizeof(spill) + spill.capacity() * sizeof(Chunk::SpilledBlock);
+    }
+}
+
+std::size_t ChunkKeyHash::operator()(const ChunkKey& key) const {
+    KeyHasher h;
+    h.Add(key.seed);
+    h.Add(key.config.size);
+    h.Add(key.config.height);
+    // + 0.0f folds -0.0f into 0.0f, which compare equal
+    h.Add(key.config.oreMult + 0.0f);
+    h.Add(key.config.treeMult + 0.0f);
+    h.Add(key.config.islandFactor + 0.0f);
+    h.Add(key.pos.x);
+    h.Add(key.pos.z);
+    return h.Get();
+}
+
+template <typename Value>
+std::shared_ptr<const Value> ChunkCache::Lru<Value>::Find(const ChunkKey& key) {
+    auto it = index.find(key);
+    if (it == index.end()) return nullptr;
+    order.splice(order.begin(), order, it->second);
+    return it->second->value;
+}
+
+template <typename Value>
+void ChunkCache::Lru<Value>::Insert(const ChunkKey& key, std::shared_ptr<const Value> value, std::size_t valueBytes) {
+    if (valueBytes > budget) return; // Would evict everything and still not fit
+
+    auto it = index.find(key);
+    if (it != index.end()) {
+        bytes -= it->second->bytes;
+        order.erase(it->second);
+        index.erase(it);
+    }
+
+    order.push_front(Entry{key, std::move(value), valueBytes});
+    index.emplace(key, order.begin());
+    bytes += valueBytes;
+
+    EvictToBudget();
+}
+
+template <typename Value>
+void ChunkCache::Lru<Value>::EvictToBudget() {
+    while (bytes > budget && !order.empty()) {
+        const Entry& oldest = order.back();
+        bytes -= oldest.bytes;
+        index.erase(oldest.key);
+        order.pop_back();
+    }
+}
+
+template <typename Value>
+void ChunkCache::Lru<Value>::Clear() {
+    order.clear();
+    index.clear();
+    bytes = 0;
+}
+
+ChunkCache::ChunkCache(std::size_t budgetBytes, std::size_t spillBudgetBytes)
+    : m_chunks(budgetBytes), m_spills(spillBudgetBytes) {
+}
+
+std::shared_ptr<const Chunk> ChunkCache::Find(const ChunkKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto chunk = m_chunks.Find(key);
+    if (chunk) {
+        m_hits++;
+    } else {
+        m_misses++;
+    }
+    return chunk;
+}
+
+void ChunkCache::Insert(const ChunkKey& key, std::shared_ptr<const Chunk> chunk) {
+    if (!chunk) return;
+    const std::size_t bytes = EntryBytes(*chunk);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_chunks.Insert(key, std::move(chunk), bytes);
+}
+
+std::shared_ptr<const ChunkCache::Spill> ChunkCache::FindSpill(const ChunkKey& key) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_spills.Find(key);
+}
+
+void ChunkCache::InsertSpill(const ChunkKey& key, std::shared_ptr<const Spill> spill) {
+    if (!spill) return;
+    const std::size_t bytes = EntryBytes(*spill);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_spills.Insert(key, std::move(spill), bytes);
+}
+
+void ChunkCache::SetBudget(std::size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_chunks.budget = budgetBytes;
+    m_chunks.EvictToBudget();
+}
+
+void ChunkCache::Clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_chunks.Clear();
+    m_spills.Clear();
+}
+
+std::size_t ChunkCache::GetBytes() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_chunks.bytes + m_spills.bytes;
+}
+
+std::size_t ChunkCache::GetHits() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+std::size_t ChunkCache::GetMisses() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
+
+} // namespace OreForged
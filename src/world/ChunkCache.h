@@ -0,0 +1,102 @@
+#pragma once
+
+#include "Chunk.h"
+#include "WorldTypes.h"
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OreForged {
+
+// Everything Chunk::Generate depends on
+struct ChunkKey {
+    uint32_t seed;
+    WorldConfig config;
+    ChunkPos pos;
+
+    bool operator==(const ChunkKey& other) const {
+        return seed == other.seed && config == other.config && pos == other.pos;
+    }
+};
+
+struct ChunkKeyHash {
+    std::size_t operator()(const ChunkKey& key) const;
+};
+
+// Default memory budget for generated chunks kept across regenerations
+constexpr std::size_t DEFAULT_CHUNK_CACHE_BYTES = 32 * 1024 * 1024;
+
+// Budget for the leaves chunks spill into their neighbours. Spills are a few
+// hundred bytes each, so this holds thousands of them, and it stays in place
+// when the chunk budget is turned down.
+constexpr std::size_t DEFAULT_SPILL_CACHE_BYTES = 1024 * 1024;
+
+// LRU cache of freshly generated chunks. Entries are immutable and shared
+// with the worlds that use them (World copies a chunk before editing it).
+// Alongside, it keeps what each chunk's decoration spilled over its edges,
+// which World needs for every neighbour of a chunk it builds.
+// Thread-safe: generation workers look up and insert concurrently.
+class ChunkCache {
+public:
+    using Spill = std::vector<Chunk::SpilledBlock>;
+
+    explicit ChunkCache(std::size_t budgetBytes = DEFAULT_CHUNK_CACHE_BYTES,
+                        std::size_t spillBudgetBytes = DEFAULT_SPILL_CACHE_BYTES);
+
+    // Cached chunk for `key`, or null. A hit makes the entry most recently used.
+    std::shared_ptr<const Chunk> Find(const ChunkKey& key);
+
+    // Adds (or replaces) an entry, then evicts least recently used entries
+    // until the cache fits its budget
+    void Insert(const ChunkKey& key, std::shared_ptr<const Chunk> chunk);
+
+    // Same for the spill of the chunk at `key` (kept apart from the chunk,
+    // so neighbours that were never built in full can have one too)
+    std::shared_ptr<const Spill> FindSpill(const ChunkKey& key);
+    void InsertSpill(const ChunkKey& key, std::shared_ptr<const Spill> spill);
+
+    // Shrinking the budget evicts immediately; 0 disables caching chunks
+    // (spills have a budget of their own)
+    void SetBudget(std::size_t budgetBytes);
+
+    void Clear();
+
+    std::size_t GetBytes() const;
+    std::size_t GetHits() const;
+    std::size_t GetMisses() const;
+
+private:
+    // One least-recently-used list of shared, immutable values
+    template <typename Value>
+    struct Lru {
+        struct Entry {
+            ChunkKey key;
+            std::shared_ptr<const Value> value;
+            std::size_t bytes;
+        };
+
+        explicit Lru(std::size_t budgetBytes) : budget(budgetBytes) {}
+
+        std::shared_ptr<const Value> Find(const ChunkKey& key);
+        void Insert(const ChunkKey& key, std::shared_ptr<const Value> value, std::size_t valueBytes);
+        void EvictToBudget();
+        void Clear();
+
+        std::size_t budget;
+        std::size_t bytes = 0;
+        std::list<Entry> order; // Most recently used first
+        std::unordered_map<ChunkKey, typename std::list<Entry>::iterator, ChunkKeyHash> index;
+    };
+
+    mutable std::mutex m_mutex;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+
+    Lru<Chunk> m_chunks;
+    Lru<Spill> m_spills;
+};
+
+} // namespace OreForged
@@ -0,0 +1,39 @@
+#include "ChunkCodec.h"
+
+namespace OreForged {
+
+namespace {
+    const char BASE64_ALPHABET[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+}
+
+void AppendBase64(std::string& out, const uint8_t* data, std::size_t len) {
+    std::size_t i = 0;
+
+    // Full 3-byte groups
+    for (; i + 2 < len; i += 3) {
+        uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8) | data[i + 2];
+        out += BASE64_ALPHABET[(triple >> 18) & 0x3F];
+        out += BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        out += BASE64_ALPHABET[(triple >> 6) & 0x3F];
+        out += BASE64_ALPHABET[triple & 0x3F];
+    }
+
+    // Tail (1 or 2 bytes) with padding
+    std::size_t rest = len - i;
+    if (rest == 1) {
+        uint32_t triple = uint32_t(data[i]) << 16;
+        out += BASE64_ALPHABET[(triple >> 18) & 0x3F];
+        out += BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        out += '=';
+        out += '=';
+    } else if (rest == 2) {
+        uint32_t triple = (uint32_t(data[i]) << 16) | (uint32_t(data[i + 1]) << 8);
+        out += BASE64_ALPHABET[(triple >> 18) & 0x3F];
+        out += BASE64_ALPHABET[(triple >> 12) & 0x3F];
+        out += BASE64_ALPHABET[(triple >> 6) & 0x3F];
+        out += '=';
+    }
+}
+
+} // namespace OreForged
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OreForged {
+
+// Binary chunk wire format (little-endian), shared with ui/src/game/ChunkCodec.ts
+//
+//   offset  size  field
+//   0       4     magic "OFCK"
+//   4       1     version
+//   5       1     flags (reserved, 0)
+//   6       2     size   (uint16)
+//   8       2     height (uint16)
+//   10      2     reserved (0)
+//   12      4     chunkX (int32)
+//   16      4     chunkZ (int32)
+//   20      N     block IDs (uint8), N = size * size * height
+//
+// Block order matches Chunk storage: index = y * size * size + z * size + x
+constexpr uint8_t CHUNK_WIRE_MAGIC[4] = {'O', 'F', 'C', 'K'};
+constexpr uint8_t CHUNK_WIRE_VERSION = 1;
+constexpr std::size_t CHUNK_WIRE_HEADER_SIZE = 20;
+
+// Native mesh payload (see ChunkMesher.h), same header up to offset 20, then
+//
+//   20      4     opaque quad count (uint32)
+//   24      4     water quad count  (uint32)
+//   28      N     block IDs, as in the chunk payload (kept for picking)
+//   ...           opaque vertices, then water vertices, 8 bytes each
+//                 (x, y, z, face, u, v, tile, ao), 4 per quad
+constexpr uint8_t CHUNK_MESH_WIRE_MAGIC[4] = {'O', 'F', 'C', 'M'};
+constexpr uint8_t CHUNK_MESH_WIRE_VERSION = 1;
+constexpr std::size_t CHUNK_MESH_WIRE_HEADER_SIZE = 28;
+
+// Little-endian readers and writers used by the chunk serializers
+inline void WriteU16LE(uint8_t* out, uint16_t v) {
+    out[0] = static_cast<uint8_t>(v);
+    out[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void WriteU32LE(uint8_t* out, uint32_t v) {
+    out[0] = static_cast<uint8_t>(v);
+    out[1] = static_cast<uint8_t>(v >> 8);
+    out[2] = static_cast<uint8_t>(v >> 16);
+    out[3] = static_cast<uint8_t>(v >> 24);
+}
+
+inline uint16_t ReadU16LE(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+inline uint32_t ReadU32LE(const uint8_t* in) {
+    return uint32_t(in[0]) | (uint32_t(in[1]) << 8) | (uint32_t(in[2]) << 16) | (uint32_t(in[3]) << 24);
+}
+
+// Size of the base64 text for a payload of `len` bytes (with padding)
+constexpr std::size_t Base64EncodedSize(std::size_t len) {
+    return ((len + 2) / 3) * 4;
+}
+
+// Appends base64 text for [data, data + len) to `out`.
+// Callers reserve `out` up front with Base64EncodedSize().
+void AppendBase64(std::string& out, const uint8_t* data, std::size_t len);
+
+} // namespace OreForged
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "WorldTypes.h"
+#include <climits>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace OreForged {
+
+// Open-addressing map from chunk position to V: keys and values in two flat
+// arrays, linear probing, at most 3/4 full. A lookup is one hash and
+// usually a single cache line of keys, with no per-entry allocation.
+// Entries are only ever added (or all cleared at once). Not thread-safe.
+template <typename V>
+class ChunkIndex {
+public:
+    ChunkIndex() = default;
+
+    // Value for `pos`, or null. Valid until the next insertion.
+    V* Find(const ChunkPos& pos) {
+        if (m_keys.empty()) return nullptr;
+        for (std::size_t i = SlotOf(pos);; i = (i + 1) & Mask()) {
+            if (m_keys[i] == pos) return &m_values[i];
+            if (m_keys[i].x == EMPTY) return nullptr;
+        }
+    }
+
+    const V* Find(const ChunkPos& pos) const {
+        return const_cast<ChunkIndex*>(this)->Find(pos);
+    }
+
+    // Like unordered_map::emplace: inserts unless `pos` is present. Returns
+    // the entry and whether it was inserted.
+    std::pair<V*, bool> Emplace(const ChunkPos& pos, V value) {
+        if (V* existing = Find(pos)) return {existing, false};
+        if ((m_size + 1) * 4 > m_keys.size() * 3) Grow();
+
+        std::size_t i = SlotOf(pos);
+        while (m_keys[i].x != EMPTY) i = (i + 1) & Mask();
+        m_keys[i] = pos;
+        m_values[i] = std::move(value);
+        m_size++;
+        return {&m_values[i], true};
+    }
+
+    template <typename F>
+    void ForEach(F&& visit) const {
+        for (std::size_t i = 0; i < m_keys.size(); i++) {
+            if (m_keys[i].x != EMPTY) visit(m_keys[i], m_values[i]);
+        }
+    }
+
+    std::size_t Size() const { return m_size; }
+
+    void Swap(ChunkIndex& other) {
+        m_keys.swap(other.m_keys);
+        m_values.swap(other.m_values);
+        std::swap(m_size, other.m_size);
+    }
+
+private:
+    // Marks a free slot; no chunk lives at x = INT_MIN
+    static constexpr int EMPTY = INT_MIN;
+    static constexpr std::size_t MIN_CAPACITY = 16;
+
+    std::vector<ChunkPos> m_keys;
+    std::vector<V> m_values;
+    std::size_t m_size = 0;
+
+    std::size_t Mask() const { return m_keys.size() - 1; }
+    std::size_t SlotOf(const ChunkPos& pos) const { return ChunkPosHash()(pos) & Mask(); }
+
+    void Grow() {
+        std::vector<ChunkPos> keys(m_keys.empty() ? MIN_CAPACITY : m_keys.size() * 2, ChunkPos{EMPTY, 0});
+        std::vector<V> values(keys.size());
+        keys.swap(m_keys);
+        values.swap(m_values);
+        for (std::size_t i = 0; i < keys.size(); i++) {
+            if (keys[i].x == EMPTY) continue;
+            std::size_t slot = SlotOf(keys[i]);
+            while (m_keys[slot].x != EMPTY) slot = (slot + 1) & Mask();
+            m_keys[slot] = keys[i];
+            m_values[slot] = std::move(values[i]);
+        }
+    }
+};
+
+} // namespace OreForged
@@ -0,0 +1,279 @@
+#include "ChunkMesher.h"
+#include "ChunkCodec.h"
+#include <cstring>
+
+namespace OreForged {
+
+namespace {
+    // Face table, same order, corners and UV layout as ChunkMesh.ts
+    struct FaceDef {
+        int dir[3];
+        int corners[4][3];
+        uint8_t uv[4][2]; // Per-corner UV as 0/1 of the tile
+        int uAxis;        // Axis the texture u runs along (quad width)
+        int vAxis;        // Axis the texture v runs along (quad height)
+    };
+
+    constexpr FaceDef FACES[6] = {
+        {{0, 1, 0},  {{0, 1, 0}, {1, 1, 0}, {1, 1, 1}, {0, 1, 1}}, {{0, 0}, {1, 0}, {1, 1}, {0, 1}}, 0, 2}, // Top
+        {{0, -1, 0}, {{0, 0, 0}, {0, 0, 1}, {1, 0, 1}, {1, 0, 0}}, {{0, 1}, {0, 0}, {1, 0}, {1, 1}}, 0, 2}, // Bottom
+        {{0, 0, 1},  {{0, 0, 1}, {0, 1, 1}, {1, 1, 1}, {1, 0, 1}}, {{0, 0}, {0, 1}, {1, 1}, {1, 0}}, 0, 1}, // Front
+        {{0, 0, -1}, {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}}, {{1, 0}, {0, 0}, {0, 1}, {1, 1}}, 0, 1}, // Back
+        {{1, 0, 0},  {{1, 0, 0}, {1, 0, 1}, {1, 1, 1}, {1, 1, 0}}, {{0, 0}, {1, 0}, {1, 1}, {0, 1}}, 2, 1}, // Right
+        {{-1, 0, 0}, {{0, 0, 0}, {0, 1, 0}, {0, 1, 1}, {0, 0, 1}}, {{1, 0}, {1, 1}, {0, 1}, {0, 0}}, 2, 1}, // Left
+    };
+
+    uint8_t Tile(int gridX, int gridY) {
+        return static_cast<uint8_t>(gridX | (gridY << 4));
+    }
+
+    // Atlas tile per block and face (4x4 grid, gridY = 0 is the bottom row)
+    uint8_t AtlasTile(BlockType type, int face) {
+        const bool isTop = face == 0;
+        const bool isBottom = face == 1;
+
+        switch (type) {
+            case BlockType::Grass:
+                if (isTop) return Tile(0, 3);
+                if (isBottom) return Tile(2, 3);
+                return Tile(3, 3);
+            case BlockType::Dirt:    return Tile(2, 3);
+            case BlockType::Stone:   return Tile(1, 3);
+            case BlockType::Water:   return Tile(0, 0);
+            case BlockType::Wood:    return (isTop || isBottom) ? Tile(1, 2) : Tile(0, 2);
+            case BlockType::Leaves:  return Tile(2, 2);
+            case BlockType::Bedrock: return Tile(1, 0);
+            case BlockType::Sand:    return Tile(3, 2);
+            case BlockType::Coal:    return Tile(0, 1);
+            case BlockType::Iron:    return Tile(1, 1);
+            case BlockType::Gold:    return Tile(2, 1);
+            case BlockType::Diamond: return Tile(3, 1);
+            case BlockType::Bronze:  return Tile(2, 0);
+            default:                 return Tile(2, 0);
+        }
+    }
+
+    // Dense copy of the chunk plus border lookups through the sampler
+    class BlockView {
+    public:
+        BlockView(const Chunk& chunk, const BlockSampler& sampler)
+            : m_size(chunk.GetSize()), m_height(chunk.GetHeight()),
+              m_originX(chunk.GetChunkX() * chunk.GetSize()),
+              m_originZ(chunk.GetChunkZ() * chunk.GetSize()),
+              m_sampler(sampler),
+              m_blocks(static_cast<std::size_t>(m_size) * m_size * m_height) {
+            chunk.CopyBlocks(m_blocks.data());
+        }
+
+        BlockType At(int x, int y, int z) const {
+            if (y < 0 || y >= m_height) return BlockType::Air;
+            if (x >= 0 && x < m_size && z >= 0 && z < m_size) {
+                return static_cast<BlockType>(m_blocks[(y * m_size + z) * m_size + x]);
+            }
+            return m_sampler ? m_sampler(m_originX + x, y, m_originZ + z) : BlockType::Air;
+        }
+
+    private:
+        int m_size;
+        int m_height;
+        int m_originX;
+        int m_originZ;
+        const BlockSampler& m_sampler;
+        std::vector<uint8_t> m_blocks;
+    };
+
+    // Occluders around one face corner, as calculateVertexAO in ChunkMesh.ts
+    uint8_t CornerAO(const BlockView& view, const int block[3], const FaceDef& face, int corner) {
+        int side1[3] = {0, 0, 0};
+        int side2[3] = {0, 0, 0};
+        if (face.dir[0] != 0) {
+            side1[1] = 1;
+            side2[2] = 1;
+        } else if (face.dir[1] != 0) {
+            side1[0] = 1;
+            side2[2] = 1;
+        } else {
+            side1[0] = 1;
+            side2[1] = 1;
+        }
+
+        int p[3];
+        for (int a = 0; a < 3; a++) {
+            p[a] = block[a] + face.corners[corner][a] + face.dir[a];
+        }
+
+        const bool s1 = view.At(p[0] + side1[0], p[1] + side1[1], p[2] + side1[2]) != BlockType::Air;
+        const bool s2 = view.At(p[0] + side2[0], p[1] + side2[1], p[2] + side2[2]) != BlockType::Air;
+        const bool c = view.At(p[0] + side1[0] + side2[0],
+                               p[1] + side1[1] + side2[1],
+                               p[2] + side1[2] + side2[2]) != BlockType::Air;
+
+        uint8_t occlusion = 0;
+        if (s1) occlusion++;
+        if (s2) occlusion++;
+        if (c && (s1 || s2)) occlusion++;
+        return occlusion;
+    }
+
+    // Append one quad covering `width` x `height` faces starting at `block`
+    void EmitQuad(std::vector<MeshVertex>& out, int faceIndex, const int block[3],
+                  int width, int height, BlockType type, const uint8_t ao[4]) {
+        const FaceDef& face = FACES[faceIndex];
+        const uint8_t tile = AtlasTile(type, faceIndex);
+
+        int extent[3] = {1, 1, 1};
+        extent[face.uAxis] = width;
+        extent[face.vAxis] = height;
+
+        for (int k = 0; k < 4; k++) {
+            MeshVertex v;
+            v.x = static_cast<uint8_t>(block[0] + face.corners[k][0] * extent[0]);
+            v.y = static_cast<uint8_t>(block[1] + face.corners[k][1] * extent[1]);
+            v.z = static_cast<uint8_t>(block[2] + face.corners[k][2] * extent[2]);
+            v.face = static_cast<uint8_t>(faceIndex);
+            v.u = static_cast<uint8_t>(face.uv[k][0] * width);
+            v.v = static_cast<uint8_t>(face.uv[k][1] * height);
+            v.tile = tile;
+            v.ao = ao[k];
+            out.push_back(v);
+        }
+    }
+}
+
+ChunkMeshData BuildChunkMesh(const Chunk& chunk, const BlockSampler& sampler) {
+    ChunkMeshData mesh;
+    const BlockView view(chunk, sampler);
+    const int dims[3] = {chunk.GetSize(), chunk.GetHeight(), chunk.GetSize()};
+
+    // Mask cell: 0 = no face, else 1 | type << 8 | ao << 16 (faces merge when equal)
+    std::vector<uint32_t> mask;
+
+    for (int f = 0; f < 6; f++) {
+        const FaceDef& face = FACES[f];
+        const int n = face.dir[0] != 0 ? 0 : (face.dir[1] != 0 ? 1 : 2);
+        const int ua = face.uAxis;
+        const int va = face.vAxis;
+        const int dimU = dims[ua];
+        const int dimV = dims[va];
+        mask.assign(static_cast<std::size_t>(dimU) * dimV, 0);
+
+        for (int slice = 0; slice < dims[n]; slice++) {
+            // 1. Visible faces of this slice; non-uniform AO is emitted as-is
+            for (int j = 0; j < dimV; j++) {
+                for (int i = 0; i < dimU; i++) {
+                    int p[3];
+                    p[n] = slice;
+                    p[ua] = i;
+                    p[va] = j;
+
+                    const BlockType type = view.At(p[0], p[1], p[2]);
+                    if (type == BlockType::Air) continue;
+
+                    const BlockType neighbor = view.At(p[0] + face.dir[0], p[1] + face.dir[1], p[2] + face.dir[2]);
+                    const bool visible = type == BlockType::Water
+                        ? neighbor == BlockType::Air
+                        : (neighbor == BlockType::Air || neighbor == BlockType::Water);
+                    if (!visible) continue;
+
+                    uint8_t ao[4];
+                    for (int k = 0; k < 4; k++) {
+                        ao[k] = CornerAO(view, p, face, k);
+                    }
+
+                    if (ao[0] == ao[1] && ao[0] == ao[2] && ao[0] == ao[3]) {
+                        mask[j * dimU + i] = 1u | (static_cast<uint32_t>(type) << 8) | (static_cast<uint32_t>(ao[0]) << 16);
+                    } else {
+                        EmitQuad(type == BlockType::Water ? mesh.water : mesh.opaque, f, p, 1, 1, type, ao);
+                    }
+                }
+            }
+
+            // 2. Greedy merge: widest run along u, then grow along v while rows match
+            for (int j = 0; j < dimV; j++) {
+                for (int i = 0; i < dimU; ) {
+                    const uint32_t key = mask[j * dimU + i];
+                    if (key == 0) {
+                        i++;
+                        continue;
+                    }
+
+                    int width = 1;
+                    while (i + width < dimU && mask[j * dimU + i + width] == key) {
+                        width++;
+                    }
+
+                    int height = 1;
+                    while (j + height < dimV) {
+                        const uint32_t* row = &mask[(j + height) * dimU + i];
+                        int k = 0;
+                        while (k < width && row[k] == key) k++;
+                        if (k < width) break;
+                        height++;
+                    }
+
+                    for (int h = 0; h < height; h++) {
+                        std::memset(&mask[(j + h) * dimU + i], 0, width * sizeof(uint32_t));
+                    }
+
+                    int p[3];
+                    p[n] = slice;
+                    p[ua] = i;
+                    p[va] = j;
+
+                    const BlockType type = static_cast<BlockType>((key >> 8) & 0xFF);
+                    const uint8_t aoValue = static_cast<uint8_t>(key >> 16);
+                    const uint8_t ao[4] = {aoValue, aoValue, aoValue, aoValue};
+                    EmitQuad(type == BlockType::Water ? mesh.water : mesh.opaque, f, p, width, height, type, ao);
+
+                    i += width;
+                }
+            }
+        }
+    }
+
+    return mesh;
+}
+
+std::string SerializeChunkMesh(const Chunk& chunk, const ChunkMeshData& mesh) {
+    const int size = chunk.GetSize();
+    const int height = chunk.GetHeight();
+    const std::size_t blockCount = static_cast<std::size_t>(size) * size * height;
+    const std::size_t opaqueBytes = mesh.opaque.size() * sizeof(MeshVertex);
+    const std::size_t waterBytes = mesh.water.size() * sizeof(MeshVertex);
+
+    std::vector<uint8_t> binary(CHUNK_MESH_WIRE_HEADER_SIZE + blockCount + opaqueBytes + waterBytes);
+    uint8_t* p = binary.data();
+
+    // Header
+    p[0] = CHUNK_MESH_WIRE_MAGIC[0];
+    p[1] = CHUNK_MESH_WIRE_MAGIC[1];
+    p[2] = CHUNK_MESH_WIRE_MAGIC[2];
+    p[3] = CHUNK_MESH_WIRE_MAGIC[3];
+    p[4] = CHUNK_MESH_WIRE_VERSION;
+    p[5] = 0;
+    WriteU16LE(p + 6, static_cast<uint16_t>(size));
+    WriteU16LE(p + 8, static_cast<uint16_t>(height));
+    WriteU16LE(p + 10, 0);
+    WriteU32LE(p + 12, static_cast<uint32_t>(chunk.GetChunkX()));
+    WriteU32LE(p + 16, static_cast<uint32_t>(chunk.GetChunkZ()));
+    WriteU32LE(p + 20, static_cast<uint32_t>(mesh.opaque.size() / 4));
+    WriteU32LE(p + 24, static_cast<uint32_t>(mesh.water.size() / 4));
+    p += CHUNK_MESH_WIRE_HEADER_SIZE;
+
+    // Blocks, then the vertex streams as raw 8-byte records
+    chunk.CopyBlocks(p);
+    p += blockCount;
+    if (opaqueBytes > 0) std::memcpy(p, mesh.opaque.data(), opaqueBytes);
+    p += opaqueBytes;
+    if (waterBytes > 0) std::memcpy(p, mesh.water.data(), waterBytes);
+
+    // Quoted base64 string, reserved once at its exact length
+    std::string json;
+    json.reserve(Base64EncodedSize(binary.size()) + 2);
+    json += '"';
+    AppendBase64(json, binary.data(), binary.size());
+    json += '"';
+    return json;
+}
+
+} // namespace OreForged
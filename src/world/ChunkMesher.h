@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Chunk.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace OreForged {
+
+// Packed vertex of a native chunk mesh (8 bytes on the wire)
+struct MeshVertex {
+    uint8_t x, y, z; // Chunk-local corner position
+    uint8_t face;    // 0=Top 1=Bottom 2=Front(Z+) 3=Back(Z-) 4=Right(X+) 5=Left(X-)
+    uint8_t u, v;    // Texture repeat coordinates across the merged quad, in blocks
+    uint8_t tile;    // Atlas tile: gridX | gridY << 4
+    uint8_t ao;      // Occluders around the vertex (0-3), brightness = 1 - ao * 0.23
+};
+static_assert(sizeof(MeshVertex) == 8, "MeshVertex is sent as raw bytes");
+
+// Quads as 4 vertices each; the index pattern (0,1,2 0,2,3) is implied
+struct ChunkMeshData {
+    std::vector<MeshVertex> opaque;
+    std::vector<MeshVertex> water; // Transparent pass
+};
+
+// Block lookup in world coordinates for samples outside the chunk.
+// Without a sampler, everything outside the chunk counts as Air.
+using BlockSampler = std::function<BlockType(int worldX, int y, int worldZ)>;
+
+// Chunks larger than this cannot be expressed with 8-bit vertex positions
+constexpr int MAX_NATIVE_MESH_DIMENSION = 255;
+
+// Greedy mesher. Emits only faces next to Air (or, for solid blocks, Water),
+// culling across chunk borders through `sampler`, and merges coplanar faces
+// of the same block type with uniform ambient occlusion into larger quads.
+// Face orientation, atlas tiles and AO match ui/src/game/ChunkMesh.ts.
+ChunkMeshData BuildChunkMesh(const Chunk& chunk, const BlockSampler& sampler = nullptr);
+
+// Mesh payload (see ChunkCodec.h), quoted base64 ready for UpdateFacetJSON
+std::string SerializeChunkMesh(const Chunk& chunk, const ChunkMeshData& mesh);
+
+} // namespace OreForged
@@ -0,0 +1,40 @@
+#include "ChunkPool.h"
+#include <algorithm>
+#include <new>
+
+namespace OreForged {
+
+FixedBlockPool::FixedBlockPool(std::size_t blockSize, std::size_t alignment, std::size_t blocksPerSlab)
+    : m_alignment((std::max)(alignment, alignof(FreeBlock))), m_blocksPerSlab(blocksPerSlab) {
+    // Every block must hold a free-list link and keep the next one aligned
+    blockSize = (std::max)(blockSize, sizeof(FreeBlock));
+    m_blockSize = (blockSize + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+void* FixedBlockPool::Allocate() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_free) {
+        // New slab, over-allocated so the first block can be aligned
+        m_slabs.emplace_back(new unsigned char[m_blockSize * m_blocksPerSlab + m_alignment]);
+        std::size_t space = m_blockSize * m_blocksPerSlab + m_alignment;
+        void* start = m_slabs.back().get();
+        std::align(m_alignment, m_blockSize * m_blocksPerSlab, start, space);
+
+        unsigned char* block = static_cast<unsigned char*>(start);
+        for (std::size_t i = m_blocksPerSlab; i-- > 0;) {
+            m_free = new (block + i * m_blockSize) FreeBlock{m_free};
+        }
+    }
+
+    FreeBlock* block = m_free;
+    m_free = block->next;
+    return block;
+}
+
+void FixedBlockPool::Deallocate(void* block) {
+    if (!block) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free = new (block) FreeBlock{m_free};
+}
+
+} // namespace OreForged
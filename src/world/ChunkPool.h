@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Chunk.h"
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace OreForged {
+
+// Fixed-size blocks carved out of slabs, recycled through a free list.
+// Thread-safe.
+class FixedBlockPool {
+public:
+    FixedBlockPool(std::size_t blockSize, std::size_t alignment, std::size_t blocksPerSlab);
+
+    void* Allocate();
+    void Deallocate(void* block);
+
+    // One pool per block size and alignment, alive for the whole program
+    template <std::size_t Size, std::size_t Align>
+    static FixedBlockPool& Get() {
+        // Never destroyed: chunks may still be released during static destruction
+        static FixedBlockPool* pool = new FixedBlockPool(Size, Align, BLOCKS_PER_SLAB);
+        return *pool;
+    }
+
+    static constexpr std::size_t BLOCKS_PER_SLAB = 64;
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    std::size_t m_blockSize;
+    std::size_t m_alignment;
+    std::size_t m_blocksPerSlab;
+    std::mutex m_mutex;
+    FreeBlock* m_free = nullptr;
+    std::vector<std::unique_ptr<unsigned char[]>> m_slabs;
+};
+
+// Allocator for std::allocate_shared: single objects come from the pool
+// for their size, anything else from the heap
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        if (n == 1) return static_cast<T*>(FixedBlockPool::Get<sizeof(T), alignof(T)>().Allocate());
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (n == 1) {
+            FixedBlockPool::Get<sizeof(T), alignof(T)>().Deallocate(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>&) const { return false; }
+};
+
+// A chunk with its shared_ptr control block in one pooled allocation, so
+// loaded chunks sit next to each other instead of all over the heap
+template <typename... Args>
+std::shared_ptr<Chunk> MakePooledChunk(Args&&... args) {
+    return std::allocate_shared<Chunk>(PoolAllocator<Chunk>(), std::forward<Args>(args)...);
+}
+
+} // namespace OreForged
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace OreForged {
+
+// Read-only memory map of a whole file (mmap / MapViewOfFile). Not open if
+// the file is missing or empty. Other handles may write to the file while it
+// is mapped, but must not shrink it.
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return m_data != nullptr; }
+    const uint8_t* Data() const { return m_data; }
+    std::size_t Size() const { return m_size; }
+
+    void Close();
+
+private:
+    const uint8_t* m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    void* m_file = nullptr;    // HANDLE
+    void* m_mapping = nullptr; // HANDLE
+#endif
+};
+
+// Flushes what has been written to the file through to the disk (fsync /
+// FlushFileBuffers). Write through a stream and flush it first.
+bool SyncFile(const std::filesystem::path& path);
+
+} // namespace OreForged
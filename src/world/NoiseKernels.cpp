@@ -0,0 +1,164 @@
+#include "NoiseKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+  #define OREFORGED_NOISE_X86 1
+  #include <immintrin.h>
+  #ifdef _MSC_VER
+    #include <intrin.h>
+    #define OREFORGED_TARGET(isa)
+  #else
+    #define OREFORGED_TARGET(isa) __attribute__((target(isa)))
+  #endif
+#endif
+
+namespace OreForged {
+
+namespace {
+    // The vector paths repeat the scalar operations one for one (no FMA, same
+    // order, exact power-of-two scaling), which is what keeps them bit-identical
+
+    void SmoothNoiseScalar(const int* worldX, const int* worldZ, int count,
+                           float divisor, uint32_t seed, float* out) {
+        for (int i = 0; i < count; i++) {
+            out[i] = smoothNoise(worldX[i] / divisor, worldZ[i] / divisor, seed);
+        }
+    }
+
+#ifdef OREFORGED_NOISE_X86
+    OREFORGED_TARGET("sse4.1")
+    inline __m128 Noise2DSse(__m128i hx, __m128i hz, __m128i seed) {
+        __m128i n = _mm_add_epi32(_mm_add_epi32(seed, hx), hz);
+        n = _mm_mullo_epi32(_mm_xor_si128(n, _mm_srli_epi32(n, 13)), _mm_set1_epi32(1274126177));
+        n = _mm_and_si128(_mm_xor_si128(n, _mm_srli_epi32(n, 16)), _mm_set1_epi32(0x7fffffff));
+        return _mm_mul_ps(_mm_cvtepi32_ps(n), _mm_set1_ps(1.0f / 2147483648.0f));
+    }
+
+    OREFORGED_TARGET("sse4.1")
+    void SmoothNoiseSse41(const int* worldX, const int* worldZ, int count,
+                          float divisor, uint32_t seed, float* out) {
+        const __m128 div = _mm_set1_ps(divisor);
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128i seedV = _mm_set1_epi32(static_cast<int>(seed));
+        const __m128i primeX = _mm_set1_epi32(374761393);
+        const __m128i primeZ = _mm_set1_epi32(668265263);
+
+        int i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 x = _mm_div_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(worldX + i))), div);
+            __m128 z = _mm_div_ps(_mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(worldZ + i))), div);
+            __m128i intX = _mm_cvttps_epi32(x);
+            __m128i intZ = _mm_cvttps_epi32(z);
+            __m128 fracX = _mm_sub_ps(x, _mm_cvtepi32_ps(intX));
+            __m128 fracZ = _mm_sub_ps(z, _mm_cvtepi32_ps(intZ));
+
+            // Lattice hash terms; (x + 1) * p == x * p + p in wrapping math
+            __m128i hx0 = _mm_mullo_epi32(intX, primeX);
+            __m128i hx1 = _mm_add_epi32(hx0, primeX);
+            __m128i hz0 = _mm_mullo_epi32(intZ, primeZ);
+            __m128i hz1 = _mm_add_epi32(hz0, primeZ);
+
+            __m128 v1 = Noise2DSse(hx0, hz0, seedV);
+            __m128 v2 = Noise2DSse(hx1, hz0, seedV);
+            __m128 v3 = Noise2DSse(hx0, hz1, seedV);
+            __m128 v4 = Noise2DSse(hx1, hz1, seedV);
+
+            __m128 invX = _mm_sub_ps(one, fracX);
+            __m128 i1 = _mm_add_ps(_mm_mul_ps(v1, invX), _mm_mul_ps(v2, fracX));
+            __m128 i2 = _mm_add_ps(_mm_mul_ps(v3, invX), _mm_mul_ps(v4, fracX));
+            __m128 r = _mm_add_ps(_mm_mul_ps(i1, _mm_sub_ps(one, fracZ)), _mm_mul_ps(i2, fracZ));
+            _mm_storeu_ps(out + i, r);
+        }
+
+        SmoothNoiseScalar(worldX + i, worldZ + i, count - i, divisor, seed, out + i);
+    }
+
+    OREFORGED_TARGET("avx2")
+    inline __m256 Noise2DAvx2(__m256i hx, __m256i hz, __m256i seed) {
+        __m256i n = _mm256_add_epi32(_mm256_add_epi32(seed, hx), hz);
+        n = _mm256_mullo_epi32(_mm256_xor_si256(n, _mm256_srli_epi32(n, 13)), _mm256_set1_epi32(1274126177));
+        n = _mm256_and_si256(_mm256_xor_si256(n, _mm256_srli_epi32(n, 16)), _mm256_set1_epi32(0x7fffffff));
+        return _mm256_mul_ps(_mm256_cvtepi32_ps(n), _mm256_set1_ps(1.0f / 2147483648.0f));
+    }
+
+    OREFORGED_TARGET("avx2")
+    void SmoothNoiseAvx2(const int* worldX, const int* worldZ, int count,
+                         float divisor, uint32_t seed, float* out) {
+        const __m256 div = _mm256_set1_ps(divisor);
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256i seedV = _mm256_set1_epi32(static_cast<int>(seed));
+        const __m256i primeX = _mm256_set1_epi32(374761393);
+        const __m256i primeZ = _mm256_set1_epi32(668265263);
+
+        int i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 x = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(worldX + i))), div);
+            __m256 z = _mm256_div_ps(_mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(worldZ + i))), div);
+            __m256i intX = _mm256_cvttps_epi32(x);
+            __m256i intZ = _mm256_cvttps_epi32(z);
+            __m256 fracX = _mm256_sub_ps(x, _mm256_cvtepi32_ps(intX));
+            __m256 fracZ = _mm256_sub_ps(z, _mm256_cvtepi32_ps(intZ));
+
+            __m256i hx0 = _mm256_mullo_epi32(intX, primeX);
+            __m256i hx1 = _mm256_add_epi32(hx0, primeX);
+            __m256i hz0 = _mm256_mullo_epi32(intZ, primeZ);
+            __m256i hz1 = _mm256_add_epi32(hz0, primeZ);
+
+            __m256 v1 = Noise2DAvx2(hx0, hz0, seedV);
+            __m256 v2 = Noise2DAvx2(hx1, hz0, seedV);
+            __m256 v3 = Noise2DAvx2(hx0, hz1, seedV);
+            __m256 v4 = Noise2DAvx2(hx1, hz1, seedV);
+
+            __m256 invX = _mm256_sub_ps(one, fracX);
+            __m256 i1 = _mm256_add_ps(_mm256_mul_ps(v1, invX), _mm256_mul_ps(v2, fracX));
+            __m256 i2 = _mm256_add_ps(_mm256_mul_ps(v3, invX), _mm256_mul_ps(v4, fracX));
+            __m256 r = _mm256_add_ps(_mm256_mul_ps(i1, _mm256_sub_ps(one, fracZ)), _mm256_mul_ps(i2, fracZ));
+            _mm256_storeu_ps(out + i, r);
+        }
+
+        // Remainder (fewer than 8) through the 4-wide path
+        SmoothNoiseSse41(worldX + i, worldZ + i, count - i, divisor, seed, out + i);
+    }
+
+    enum class NoiseIsa { Scalar, Sse41, Avx2 };
+
+    NoiseIsa DetectIsa() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        const int maxLeaf = info[0];
+        __cpuid(info, 1);
+        const bool sse41 = (info[2] & (1 << 19)) != 0;
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        const bool avx = (info[2] & (1 << 28)) != 0;
+        bool avx2 = false;
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+        if (avx2) return NoiseIsa::Avx2;
+        if (sse41) return NoiseIsa::Sse41;
+        return NoiseIsa::Scalar;
+#else
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return NoiseIsa::Avx2;
+        if (__builtin_cpu_supports("sse4.1")) return NoiseIsa::Sse41;
+        return NoiseIsa::Scalar;
+#endif
+    }
+#endif
+}
+
+void SmoothNoiseBatch(const int* worldX, const int* worldZ, int count,
+                      float divisor, uint32_t seed, float* out) {
+#ifdef OREFORGED_NOISE_X86
+    static const NoiseIsa isa = DetectIsa();
+    switch (isa) {
+        case NoiseIsa::Avx2:  SmoothNoiseAvx2(worldX, worldZ, count, divisor, seed, out); return;
+        case NoiseIsa::Sse41: SmoothNoiseSse41(worldX, worldZ, count, divisor, seed, out); return;
+        case NoiseIsa::Scalar: break;
+    }
+#endif
+    SmoothNoiseScalar(worldX, worldZ, count, divisor, seed, out);
+}
+
+} // namespace OreForged
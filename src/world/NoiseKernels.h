@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace OreForged {
+
+// Simple hash-based noise function, [0, 1).
+// Hashing is done in uint32_t: same bits as the wrapping int math it replaces.
+inline float noise2D(int x, int z, uint32_t seed) {
+    uint32_t n = seed + static_cast<uint32_t>(x) * 374761393u + static_cast<uint32_t>(z) * 668265263u;
+    n = (n ^ (n >> 13)) * 1274126177u;
+    return ((n ^ (n >> 16)) & 0x7fffffff) / 2147483648.0f;
+}
+
+// Smooth noise: bilinear blend of the four surrounding lattice values
+// (coordinates truncate toward zero)
+inline float smoothNoise(float x, float z, uint32_t seed) {
+    int intX = static_cast<int>(x);
+    int intZ = static_cast<int>(z);
+    float fracX = x - intX;
+    float fracZ = z - intZ;
+
+    float v1 = noise2D(intX, intZ, seed);
+    float v2 = noise2D(intX + 1, intZ, seed);
+    float v3 = noise2D(intX, intZ + 1, seed);
+    float v4 = noise2D(intX + 1, intZ + 1, seed);
+
+    float i1 = v1 * (1 - fracX) + v2 * fracX;
+    float i2 = v3 * (1 - fracX) + v4 * fracX;
+    return i1 * (1 - fracZ) + i2 * fracZ;
+}
+
+// Batched out[i] = smoothNoise(worldX[i] / divisor, worldZ[i] / divisor, seed)
+// for i in [0, count). Runs 8 (AVX2) or 4 (SSE4.1) columns per step when the
+// CPU supports it, scalar otherwise; results are bit-identical either way.
+void SmoothNoiseBatch(const int* worldX, const int* worldZ, int count,
+                      float divisor, uint32_t seed, float* out);
+
+} // namespace OreForged
@@ -0,0 +1,274 @@
+#include "RegionStore.h"
+#include "ChunkCodec.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace OreForged {
+
+namespace {
+    constexpr uint8_t REGION_MAGIC[4] = {'O', 'F', 'R', 'G'};
+    constexpr uint32_t REGION_VERSION = 2;
+    constexpr std::size_t REGION_CHUNKS = RegionStore::REGION_SIZE * RegionStore::REGION_SIZE;
+    constexpr std::size_t REGION_TABLE_OFFSET = 32;
+    constexpr std::size_t REGION_HEADER_SIZE = REGION_TABLE_OFFSET + REGION_CHUNKS * 8;
+
+    // Floor division, so chunk -1 is in region -1
+    int FloorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+    }
+
+    uint32_t FloatBits(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+}
+
+RegionStore::RegionStore(std::filesystem::path directory, uint32_t seed, const WorldConfig& config)
+    : m_directory(std::move(directory)), m_seed(seed), m_config(config) {}
+
+ChunkPos RegionStore::RegionOf(const ChunkPos& pos) {
+    return {FloorDiv(pos.x, REGION_SIZE), FloorDiv(pos.z, REGION_SIZE)};
+}
+
+int RegionStore::TableIndex(const ChunkPos& pos) {
+    const ChunkPos region = RegionOf(pos);
+    const int localX = pos.x - region.x * REGION_SIZE;
+    const int localZ = pos.z - region.z * REGION_SIZE;
+    return localZ * REGION_SIZE + localX;
+}
+
+std::filesystem::path RegionStore::RegionPath(const ChunkPos& region) const {
+    return m_directory / ("r." + std::to_string(region.x) + "." + std::to_string(region.z) + ".ofr");
+}
+
+void RegionStore::WriteTable(uint8_t* out, const std::vector<TableEntry>& table) {
+    for (std::size_t i = 0; i < REGION_CHUNKS; i++) {
+        WriteU32LE(out + i * 8, table[i].offset);
+        WriteU32LE(out + i * 8 + 4, table[i].length);
+    }
+}
+
+std::vector<uint8_t> RegionStore::MakeHeader() const {
+    // Empty table; callers fill it in
+    std::vector<uint8_t> header(REGION_HEADER_SIZE, 0);
+    std::memcpy(header.data(), REGION_MAGIC, sizeof(REGION_MAGIC));
+    WriteU32LE(header.data() + 4, REGION_VERSION);
+    WriteU32LE(header.data() + 8, m_seed);
+    WriteU32LE(header.data() + 12, static_cast<uint32_t>(m_config.size));
+    WriteU32LE(header.data() + 16, static_cast<uint32_t>(m_config.height));
+    WriteU32LE(header.data() + 20, FloatBits(m_config.oreMult));
+    WriteU32LE(header.data() + 24, FloatBits(m_config.treeMult));
+    WriteU32LE(header.data() + 28, FloatBits(m_config.islandFactor));
+    return header;
+}
+
+bool RegionStore::IsOwnHeader(const uint8_t* data, std::size_t size) const {
+    // Everything up to the table must match what this store would write
+    const std::vector<uint8_t> header = MakeHeader();
+    return size >= REGION_HEADER_SIZE && std::memcmp(data, header.data(), REGION_TABLE_OFFSET) == 0;
+}
+
+RegionStore::Region& RegionStore::GetRegion(const ChunkPos& regionPos) {
+    auto it = m_regions.find(regionPos);
+    if (it != m_regions.end()) return it->second;
+
+    Region& region = m_regions[regionPos];
+    region.file = MappedFile(RegionPath(regionPos));
+    if (!region.file.IsOpen()) return region;
+
+    // Another world's region (or an unreadable one) counts as empty; the
+    // next save here starts the file over
+    const uint8_t* data = region.file.Data();
+    if (!IsOwnHeader(data, region.file.Size())) {
+        std::cerr << "Ignoring region file of another world (or invalid) " << RegionPath(regionPos) << std::endl;
+        region.file.Close();
+        return region;
+    }
+
+    region.table.resize(REGION_CHUNKS);
+    for (std::size_t i = 0; i < REGION_CHUNKS; i++) {
+        const uint8_t* entry = data + REGION_TABLE_OFFSET + i * 8;
+        region.table[i] = {ReadU32LE(entry), ReadU32LE(entry + 4)};
+    }
+    return region;
+}
+
+std::shared_ptr<Chunk> RegionStore::Load(const ChunkPos& pos) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Region& region = GetRegion(RegionOf(pos));
+    if (region.table.empty() || !region.file.IsOpen()) return nullptr;
+
+    const TableEntry& entry = region.table[TableIndex(pos)];
+    if (entry.offset == 0 || static_cast<std::size_t>(entry.offset) + entry.length > region.file.Size()) {
+        return nullptr;
+    }
+
+    auto chunk = Chunk::DeserializeBinary(region.file.Data() + entry.offset, entry.length);
+    if (!chunk || chunk->GetChunkX() != pos.x || chunk->GetChunkZ() != pos.z) {
+        return nullptr;
+    }
+    return chunk;
+}
+
+bool RegionStore::Save(const std::vector<std::shared_ptr<const Chunk>>& chunks) {
+    std::unordered_map<ChunkPos, std::vector<std::shared_ptr<const Chunk>>, ChunkPosHash> byRegion;
+    for (const auto& chunk : chunks) {
+        byRegion[RegionOf({chunk->GetChunkX(), chunk->GetChunkZ()})].push_back(chunk);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::error_code error;
+    std::filesystem::create_directories(m_directory, error);
+
+    bool ok = true;
+    for (const auto& [regionPos, regionChunks] : byRegion) {
+        ok &= WriteRegion(regionPos, GetRegion(regionPos), regionChunks);
+    }
+    return ok;
+}
+
+bool RegionStore::WriteRegion(const ChunkPos& regionPos, Region& region,
+                              const std::vector<std::shared_ptr<const Chunk>>& chunks) {
+    const std::filesystem::path path = RegionPath(regionPos);
+
+    // Writes go through a file handle; the map is rebuilt afterwards since
+    // appends grow the file past it
+    region.file.Close();
+
+    if (region.table.empty()) {
+        // New region (or another world's): header with an empty table,
+        // renamed over so another world's file stays whole until then
+        const std::filesystem::path tmpPath = path.string() + ".tmp";
+        const std::vector<uint8_t> header = MakeHeader();
+        {
+            std::ofstream create(tmpPath, std::ios::binary | std::ios::trunc);
+            create.write(reinterpret_cast<const char*>(header.data()), header.size());
+            if (!create) {
+                std::cerr << "Failed to create region file " << path << std::endl;
+                return false;
+            }
+        }
+        std::error_code error;
+        if (SyncFile(tmpPath)) std::filesystem::rename(tmpPath, path, error);
+        else error = std::make_error_code(std::errc::io_error);
+        if (error) {
+            std::cerr << "Failed to create region file " << path << ": " << error.message() << std::endl;
+            std::filesystem::remove(tmpPath, error);
+            return false;
+        }
+        region.table.assign(REGION_CHUNKS, TableEntry{});
+    }
+
+    std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(0, std::ios::end);
+    std::size_t fileSize = static_cast<std::size_t>(file.tellp());
+
+    // Records are only ever appended: the ones the table points at now stay
+    // intact until the new table is written
+    std::vector<TableEntry> table = region.table;
+    for (const auto& chunk : chunks) {
+        const std::vector<uint8_t> record = chunk->SerializeBinary();
+        TableEntry& entry = table[TableIndex({chunk->GetChunkX(), chunk->GetChunkZ()})];
+        entry.offset = static_cast<uint32_t>(fileSize);
+        entry.length = static_cast<uint32_t>(record.size());
+        fileSize += record.size();
+        file.write(reinterpret_cast<const char*>(record.data()), record.size());
+    }
+    file.flush();
+
+    // Then the table, which commits them. The records reach the disk first,
+    // so the table never points at data that isn't there after a crash
+    bool ok = file && SyncFile(path);
+    if (ok) {
+        std::vector<uint8_t> tableBytes(REGION_CHUNKS * 8);
+        WriteTable(tableBytes.data(), table);
+        file.seekp(REGION_TABLE_OFFSET);
+        file.write(reinterpret_cast<const char*>(tableBytes.data()), tableBytes.size());
+        file.flush();
+        ok = file && SyncFile(path);
+    }
+    file.close();
+    if (!ok) {
+        std::cerr << "Failed to write region file " << path << std::endl;
+        region.file = MappedFile(path);
+        return false;
+    }
+    region.table = std::move(table);
+
+    std::size_t liveBytes = 0;
+    for (const TableEntry& entry : region.table) liveBytes += entry.length;
+    if (fileSize - REGION_HEADER_SIZE > 2 * liveBytes) {
+        region.file = MappedFile(path);
+        return CompactRegion(regionPos, region);
+    }
+
+    region.file = MappedFile(path);
+    return true;
+}
+
+bool RegionStore::CompactRegion(const ChunkPos& regionPos, Region& region) {
+    const std::filesystem::path path = RegionPath(regionPos);
+    const std::filesystem::path tmpPath = path.string() + ".tmp";
+    if (!region.file.IsOpen()) return false;
+
+    // Live records back to back after a fresh header
+    std::vector<uint8_t> data = MakeHeader();
+    std::vector<TableEntry> table(REGION_CHUNKS);
+    for (std::size_t i = 0; i < REGION_CHUNKS; i++) {
+        const TableEntry& entry = region.table[i];
+        if (entry.offset == 0 || static_cast<std::size_t>(entry.offset) + entry.length > region.file.Size()) continue;
+        table[i] = {static_cast<uint32_t>(data.size()), entry.length};
+        data.insert(data.end(), region.file.Data() + entry.offset, region.file.Data() + entry.offset + entry.length);
+    }
+    WriteTable(data.data() + REGION_TABLE_OFFSET, table);
+
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(data.data()), data.size());
+        if (!file) {
+            std::cerr << "Failed to compact region file " << path << std::endl;
+            return true; // The uncompacted region is still good
+        }
+    }
+    if (!SyncFile(tmpPath)) {
+        std::cerr << "Failed to compact region file " << path << std::endl;
+        std::error_code error;
+        std::filesystem::remove(tmpPath, error);
+        return true;
+    }
+
+    // Renamed over, so a crash leaves either the old file or the new one
+    region.file.Close();
+    std::error_code error;
+    std::filesystem::rename(tmpPath, path, error);
+    if (error) {
+        std::cerr << "Failed to compact region file " << path << ": " << error.message() << std::endl;
+        std::filesystem::remove(tmpPath, error);
+    } else {
+        region.table = std::move(table);
+    }
+    region.file = MappedFile(path);
+    return true;
+}
+
+void RegionStore::RemoveOtherWorlds() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_regions.clear(); // Unmaps everything first; regions reopen on use
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+        if (entry.path().extension() != ".ofr") continue;
+
+        bool own = false;
+        {
+            MappedFile file(entry.path());
+            own = file.IsOpen() && IsOwnHeader(file.Data(), file.Size());
+        }
+        if (!own) {
+            std::filesystem::remove(entry.path(), error);
+        }
+    }
+}
+
+} // namespace OreForged
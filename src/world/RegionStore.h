@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Chunk.h"
+#include "MappedFile.h"
+#include "WorldTypes.h"
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace OreForged {
+
+// Saved chunks, grouped into region files of REGION_SIZE x REGION_SIZE chunks
+// (r.<regionX>.<regionZ>.ofr in the store's directory).
+//
+//   offset  size  field
+//   0       4     magic "OFRG"
+//   4       4     version (uint32)
+//   8       4     world seed (uint32)
+//   12      20    world config: size, height (int32), oreMult, treeMult,
+//                 islandFactor (float32)
+//   32      8*N   offset table, N = REGION_SIZE^2, index = localZ * REGION_SIZE + localX:
+//                 chunk record offset (uint32, 0 = not stored), record length (uint32)
+//   ...           chunk records in the binary wire format (see ChunkCodec.h)
+//
+// Regions are read through a memory map; a chunk is only decoded when it is
+// loaded. A region stamped with another seed or config belongs to another
+// world and reads as empty.
+//
+// Saving appends each record and then rewrites the table, so the table write
+// is the commit point: an interrupted save leaves the table pointing at the
+// previous, intact records. A save costs one record per saved chunk, however
+// big the region is. Superseded records are dead space; once a region holds
+// more dead than live bytes it is compacted (rewritten aside and renamed
+// over).
+//
+// Thread-safe.
+class RegionStore {
+public:
+    static constexpr int REGION_SIZE = 16;
+
+    // Stores the chunks of the world with this seed and config
+    RegionStore(std::filesystem::path directory, uint32_t seed, const WorldConfig& config);
+
+    // Decodes a stored chunk; null if it was never saved (or is unreadable)
+    std::shared_ptr<Chunk> Load(const ChunkPos& pos);
+
+    // Writes the chunks into their regions. Returns false if any write failed.
+    bool Save(const std::vector<std::shared_ptr<const Chunk>>& chunks);
+
+    // Delete the region files stamped with another world
+    void RemoveOtherWorlds();
+
+    const std::filesystem::path& GetDirectory() const { return m_directory; }
+    uint32_t GetSeed() const { return m_seed; }
+    const WorldConfig& GetConfig() const { return m_config; }
+
+private:
+    struct TableEntry {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+
+    struct Region {
+        MappedFile file;
+        std::vector<TableEntry> table; // REGION_SIZE^2 entries, empty table if no file yet
+    };
+
+    std::filesystem::path m_directory;
+    uint32_t m_seed;
+    WorldConfig m_config;
+    std::mutex m_mutex;
+    std::unordered_map<ChunkPos, Region, ChunkPosHash> m_regions; // Keyed by region coordinates
+
+    static ChunkPos RegionOf(const ChunkPos& pos);
+    static int TableIndex(const ChunkPos& pos);
+    std::filesystem::path RegionPath(const ChunkPos& region) const;
+
+    static void WriteTable(uint8_t* out, const std::vector<TableEntry>& table);
+    std::vector<uint8_t> MakeHeader() const;
+    bool IsOwnHeader(const uint8_t* data, std::size_t size) const;
+
+    // Opened (and its table read) on first use. Caller holds m_mutex.
+    Region& GetRegion(const ChunkPos& region);
+    bool WriteRegion(const ChunkPos& regionPos, Region& region,
+                     const std::vector<std::shared_ptr<const Chunk>>& chunks);
+    // Rewrites the region with only its live records. Caller holds m_mutex.
+    bool CompactRegion(const ChunkPos& regionPos, Region& region);
+};
+
+} // namespace OreForged
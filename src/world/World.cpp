@@ -1,121 +1,726 @@
 #include "World.h"
+#include "ChunkPool.h"
+#include "core/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 namespace OreForged {
 
-World::World(uint32_t seed)
-    : m_seed(seed)
-{
+namespace {
+    // A saved chunk, if the store holds this world (seed and config) and
+    // the chunk's dimensions match
+    std::shared_ptr<const Chunk> LoadStoredChunk(RegionStore& store, uint32_t seed, const WorldConfig& config,
+                                                 const ChunkPos& pos) {
+        if (store.GetSeed() != seed || !(store.GetConfig() == config)) {
+            return nullptr;
+        }
+        auto chunk = store.Load(pos);
+        if (!chunk || chunk->GetSize() != config.size || chunk->GetHeight() != config.height) {
+            return nullptr;
+        }
+        return chunk;
+    }
+    
+    std::atomic<uint64_t> g_nextEpoch{1};
+    
+    // Squared distance from a chunk to the visual center of a square of
+    // chunks loaded around `center` (which has one extra chunk on the
+    // negative side, see LoadChunksAroundPosition)
+    float DistanceSq(const ChunkPos& pos, int centerChunkX, int centerChunkZ) {
+        const float dx = pos.x - centerChunkX + 0.5f;
+        const float dz = pos.z - centerChunkZ + 0.5f;
+        return dx * dx + dz * dz;
+    }
+    
+    // The chunk this thread's last GetBlock landed in
+    struct LastChunk {
+        const World* world = nullptr;
+        uint64_t epoch = 0;
+        ChunkPos pos{0, 0};
+        std::shared_ptr<const Chunk> chunk;
+    };
+    thread_local LastChunk t_lastChunk;
+    
+    // Runs job(i) for every i < count on a bounded set of workers, the
+    // calling thread included
+    template <typename Job>
+    void ParallelFor(std::size_t count, const Job& job) {
+        std::atomic<std::size_t> nextJob{0};
+        auto worker = [&]() {
+            for (std::size_t i = nextJob++; i < count; i = nextJob++) {
+                job(i);
+            }
+        };
+        
+        unsigned hardwareThreads = (std::max)(1u, std::thread::hardware_concurrency());
+        std::size_t workerCount = (std::min)(count, static_cast<std::size_t>(hardwareThreads));
+        
+        std::vector<std::thread> pool;
+        pool.reserve(workerCount > 0 ? workerCount - 1 : 0);
+        for (std::size_t i = 1; i < workerCount; i++) {
+            pool.emplace_back([&worker]() {
+                PROFILE_THREAD("chunk worker");
+                worker();
+            });
+        }
+        worker(); // Calling thread takes a share of the jobs too
+        for (auto& t : pool) {
+            t.join();
+        }
+    }
+}
+
+World::World(uint32_t seed, std::shared_ptr<ChunkCache> cache)
+    : m_cache(cache ? std::move(cache) : std::make_shared<ChunkCache>()),
+      m_epoch(g_nextEpoch++) {
     // Default config - Size 9 as requested ("Try 9")
-    m_config.size = 9;
-    m_config.height = 32;
-    m_config.oreMult = 1.0f; 
-    m_config.treeMult = 1.0f;
+    WorldConfig config;
+    config.size = 9;
+    config.height = 32;
+    config.oreMult = 1.0f; 
+    config.treeMult = 1.0f;
+    m_params = std::make_shared<const Params>(Params{seed, config});
+    m_chunkSize = config.size;
+}
+
+std::shared_ptr<const World::Params> World::LoadParams() const {
+    return std::atomic_load(&m_params);
+}
+
+void World::NextEpoch() {
+    m_epoch.store(g_nextEpoch++, std::memory_order_release);
+}
+
+World::Shard& World::ShardFor(const ChunkPos& pos) const {
+    return m_shards[ChunkPosHash()(pos) >> (std::numeric_limits<std::size_t>::digits - SHARD_BITS)];
 }
 
 Block World::GetBlock(int x, int y, int z) const {
+    const int size = m_chunkSize;
     int chunkX, chunkZ, localX, localZ;
-    WorldToLocal(x, z, chunkX, chunkZ, localX, localZ);
+    WorldToLocal(x, z, size, chunkX, chunkZ, localX, localZ);
     
-    const Chunk* chunk = GetChunk(chunkX, chunkZ);
-    if (!chunk) {
+    const ChunkPos pos{chunkX, chunkZ};
+    // Read before the lookup, so a chunk replaced meanwhile is cached under
+    // an epoch that is already stale
+    const uint64_t epoch = m_epoch.load(std::memory_order_acquire);
+    LastChunk& last = t_lastChunk;
+    if (last.world == this && last.epoch == epoch && last.pos == pos) {
+        // A size mismatch means a regeneration changed the size mid-lookup
+        if (last.chunk->GetSize() != size) {
+            return Block{BlockType::Air};
+        }
+        return last.chunk->GetBlock(localX, y, localZ);
+    }
+    
+    auto chunk = GetChunk(chunkX, chunkZ); // Loads it if saved but not loaded yet
+    if (!chunk || chunk->GetSize() != size) {
         return Block{BlockType::Air};
     }
     
-    return chunk->GetBlock(localX, y, localZ);
+    const Block block = chunk->GetBlock(localX, y, localZ);
+    last.world = this;
+    last.epoch = epoch;
+    last.pos = pos;
+    last.chunk = std::move(chunk);
+    return block;
 }
 
 void World::SetBlock(int x, int y, int z, BlockType type) {
+    const auto params = LoadParams();
     int chunkX, chunkZ, localX, localZ;
-    WorldToLocal(x, z, chunkX, chunkZ, localX, localZ);
+    WorldToLocal(x, z, params->config.size, chunkX, chunkZ, localX, localZ);
     
-    Chunk* chunk = GetChunk(chunkX, chunkZ);
-    if (!chunk) {
-        // Generate chunk if it doesn't exist
-        GenerateChunk(chunkX, chunkZ);
-        chunk = GetChunk(chunkX, chunkZ);
+    const ChunkPos pos{chunkX, chunkZ};
+    Shard& shard = ShardFor(pos);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    std::shared_ptr<const Chunk>* found = shard.chunks.Find(pos);
+    std::shared_ptr<const Chunk> generated;
+    if (!found) {
+        // Generate chunk if it doesn't exist (without holding up the shard)
+        lock.unlock();
+        generated = LoadOrGenerateChunk(*params, pos);
+        lock.lock();
+        found = shard.chunks.Find(pos); // May have been loaded meanwhile
     }
     
-    if (chunk) {
-        chunk->SetBlock(localX, y, localZ, type);
+    // Regenerated since the lookup: the edit belongs to a world that is gone
+    // (checked under the shard lock, which Regenerate takes after the swap)
+    if (LoadParams() != params) return;
+    
+    if (!found) {
+        found = shard.chunks.Emplace(pos, std::move(generated)).first;
+        shard.unsent.insert(pos);
     }
+    shard.unsaved.insert(pos);
+    
+    // Copy on write: the cache, a snapshot or another thread's GetBlock still
+    // holds this version. Our own GetBlock pin doesn't count. use_count() is
+    // only a relaxed load: the count is read by taking a reference instead,
+    // a read-modify-write that the fence turns into an acquire, so whoever
+    // dropped their reference before is done reading what we overwrite.
+    std::shared_ptr<const Chunk>& slot = *found;
+    LastChunk& last = t_lastChunk;
+    const bool pinned = last.world == this && last.chunk == slot;
+    const long owners = std::shared_ptr<const Chunk>(slot).use_count() - 1;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (owners > (pinned ? 2 : 1)) {
+        slot = MakePooledChunk(*slot);
+        NextEpoch();
+    }
+    // Every chunk is created non-const (MakePooledChunk), and this one is ours alone
+    Chunk* chunk = const_cast<Chunk*>(slot.get());
+    chunk->SetBlock(localX, y, localZ, type);
+}
+
+std::shared_ptr<const Chunk> World::FindLoaded(const ChunkPos& pos) const {
+    Shard& shard = ShardFor(pos);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const std::shared_ptr<const Chunk>* chunk = shard.chunks.Find(pos);
+    return chunk ? *chunk : nullptr;
 }
 
-Chunk* World::GetChunk(int chunkX, int chunkZ) {
-    auto it = m_chunks.find({chunkX, chunkZ});
-    if (it != m_chunks.end()) {
-        return it->second.get();
+std::shared_ptr<const Chunk> World::GetChunk(int chunkX, int chunkZ) const {
+    const ChunkPos pos{chunkX, chunkZ};
+    if (auto chunk = FindLoaded(pos)) {
+        return chunk;
     }
-    return nullptr;
+    
+    // Decoded on first access, so startup only pays for what gets looked at
+    const auto store = std::atomic_load(&m_regions);
+    if (!store) return nullptr;
+    const auto params = LoadParams();
+    auto chunk = LoadStoredChunk(*store, params->seed, params->config, pos);
+    if (!chunk) return nullptr;
+    
+    Shard& shard = ShardFor(pos);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (LoadParams() != params) return nullptr;
+    auto [slot, inserted] = shard.chunks.Emplace(pos, std::move(chunk)); // Or whoever loaded it first
+    if (inserted) shard.unsent.insert(pos);
+    return *slot;
 }
 
-const Chunk* World::GetChunk(int chunkX, int chunkZ) const {
-    auto it = m_chunks.find({chunkX, chunkZ});
-    if (it != m_chunks.end()) {
-        return it->second.get();
+std::shared_ptr<const Chunk> World::FindSavedOrCached(const Params& params, const ChunkPos& pos, bool* fromStore) {
+    if (fromStore) *fromStore = false;
+    if (const auto store = std::atomic_load(&m_regions)) {
+        if (auto stored = LoadStoredChunk(*store, params.seed, params.config, pos)) {
+            if (fromStore) *fromStore = true;
+            return stored;
+        }
     }
-    return nullptr;
+    return m_cache->Find(ChunkKey{params.seed, params.config, pos});
+}
+
+std::shared_ptr<const Chunk> World::LoadOrGenerateChunk(const Params& params, const ChunkPos& pos, bool* fromStore) {
+    if (auto chunk = FindSavedOrCached(params, pos, fromStore)) {
+        return chunk;
+    }
+    return BuildChunks(params, {pos}).front();
+}
+
+std::vector<std::shared_ptr<const Chunk>> World::BuildChunks(const Params& params, const std::vector<ChunkPos>& positions,
+                                                             const ChunkReadyCallback& onChunkReady,
+                                                             const std::atomic<bool>* cancel) {
+    // Everything within one chunk of a requested position gets terrain, ores
+    // and trees, nearest the front of `positions` first
+    ChunkIndex<std::size_t> requested; // Position -> index in `positions`
+    ChunkIndex<std::size_t> windowIndex; // Position -> index in `window`
+    std::vector<ChunkPos> window;
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        requested.Emplace(positions[i], i);
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                const ChunkPos pos{positions[i].x + dx, positions[i].z + dz};
+                if (windowIndex.Emplace(pos, window.size()).second) {
+                    window.push_back(pos);
+                }
+            }
+        }
+    }
+    
+    std::vector<std::shared_ptr<Chunk>> decorated(window.size()); // Requested positions only
+    std::vector<std::shared_ptr<const ChunkCache::Spill>> spills(window.size());
+    std::vector<std::shared_ptr<const Chunk>> built(positions.size());
+    // Neighbourhood chunks (itself included) each requested chunk still waits for
+    std::unique_ptr<std::atomic<int>[]> pending(new std::atomic<int>[positions.size()]);
+    for (std::size_t i = 0; i < positions.size(); i++) {
+        pending[i] = 9;
+    }
+    auto neighbourDone = [&](const ChunkPos& pos, auto&& onComplete) {
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                const std::size_t* i = requested.Find({pos.x + dx, pos.z + dz});
+                if (i && pending[*i].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    onComplete(*i);
+                }
+            }
+        }
+    };
+    
+    // The rest of the window only matters for its spill, which is cached:
+    // loaded or previously built neighbours cost a lookup, not a generation
+    std::vector<std::size_t> work; // Window indices still to generate
+    for (std::size_t w = 0; w < window.size(); w++) {
+        if (!requested.Find(window[w])) {
+            spills[w] = m_cache->FindSpill(ChunkKey{params.seed, params.config, window[w]});
+        }
+        if (spills[w]) {
+            // Can't complete a neighbourhood: its requested chunk isn't generated yet
+            neighbourDone(window[w], [](std::size_t) {});
+        } else {
+            work.push_back(w);
+        }
+    }
+    
+    // A requested chunk whose whole neighbourhood is decorated takes in what
+    // the neighbours spilled over its edges. Only this chunk is written, and
+    // the spills it reads are final, so finishing runs alongside other work.
+    auto finish = [&](std::size_t i) {
+        const ChunkPos pos = positions[i];
+        std::shared_ptr<Chunk> chunk = decorated[*windowIndex.Find(pos)];
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dx = -1; dx <= 1; dx++) {
+                if (dx == 0 && dz == 0) continue;
+                chunk->ApplySpill(*spills[*windowIndex.Find({pos.x + dx, pos.z + dz})]);
+            }
+        }
+        // Ores, trees and spills overwrite terrain; drop palette entries they orphaned
+        chunk->Compact();
+        m_cache->Insert(ChunkKey{params.seed, params.config, pos}, chunk);
+        if (onChunkReady) onChunkReady(*chunk);
+        built[i] = std::move(chunk);
+    };
+    
+    // Generation only depends on seed, config and chunk position, so the
+    // window can be decorated in any order, in parallel. These are the
+    // phases of Chunk::Generate: ores stay in for spill-only chunks, since
+    // a column topped with ore grows no tree.
+    const WorldConfig& config = params.config;
+    auto decorate = [&](Chunk& chunk, ChunkCache::Spill& spill) {
+        chunk.GenerateTerrain(params.seed, config.oreMult, config.islandFactor);
+        chunk.GenerateOres(params.seed, config.oreMult);
+        chunk.GenerateTrees(params.seed, config.treeMult, &spill);
+    };
+    ParallelFor(work.size(), [&](std::size_t job) {
+        if (cancel && *cancel) return;
+        const std::size_t w = work[job];
+        const ChunkPos pos = window[w];
+        auto spill = std::make_shared<ChunkCache::Spill>();
+        if (requested.Find(pos)) {
+            auto chunk = MakePooledChunk(pos.x, pos.z, config.size, config.height);
+            decorate(*chunk, *spill);
+            decorated[w] = std::move(chunk);
+        } else {
+            // Scratch chunk: dropped as soon as its spill is out
+            Chunk scratch(pos.x, pos.z, config.size, config.height);
+            decorate(scratch, *spill);
+        }
+        m_cache->InsertSpill(ChunkKey{params.seed, params.config, pos}, spill);
+        spills[w] = std::move(spill);
+        
+        // Whoever completes a neighbourhood finishes its chunk
+        neighbourDone(pos, finish);
+    });
+    return built;
 }
 
 void World::GenerateChunk(int chunkX, int chunkZ) {
-    ChunkPos pos{chunkX, chunkZ};
+    const ChunkPos pos{chunkX, chunkZ};
     
     // Don't regenerate if already exists
-    if (m_chunks.find(pos) != m_chunks.end()) {
+    if (FindLoaded(pos)) {
         return;
     }
     
     // Create new chunk with current config
-    auto chunk = std::make_unique<Chunk>(chunkX, chunkZ, m_config.size, m_config.height);
-    chunk->Generate(m_seed, m_config.oreMult, m_config.treeMult, m_config.islandFactor);
+    const auto params = LoadParams();
+    bool fromStore = false;
+    auto chunk = LoadOrGenerateChunk(*params, pos, &fromStore);
     
-    m_chunks[pos] = std::move(chunk);
+    Shard& shard = ShardFor(pos);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (LoadParams() == params && shard.chunks.Emplace(pos, std::move(chunk)).second) {
+        shard.unsent.insert(pos);
+        if (!fromStore) shard.unsaved.insert(pos);
+    }
 }
 
 void World::Regenerate(uint32_t seed, const WorldConfig& config) {
     std::cout << "World::Regenerate called with seed: " << seed << std::endl;
-    m_seed = seed;
-    m_config = config; // Update config
+    // Publish the new world first: anything committed for the old one after
+    // this fails its params check
+    std::atomic_store(&m_params, std::make_shared<const Params>(Params{seed, config}));
+    m_chunkSize = config.size;
+    std::atomic_store(&m_regions, std::shared_ptr<RegionStore>());
     
-    m_chunks.clear();
+    for (Shard& shard : m_shards) {
+        ChunkIndex<std::shared_ptr<const Chunk>> old;
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            old.Swap(shard.chunks);
+            shard.unsaved.clear();
+            shard.unsent.clear();
+        }
+        // Old chunks are freed (or left to snapshot holders) outside the lock
+    }
+    NextEpoch();
     std::cout << "Chunks cleared" << std::endl;
 }
 
-void World::LoadChunksAroundPosition(int centerChunkX, int centerChunkZ, int radius) {
+bool World::LoadChunksAroundPosition(int centerChunkX, int centerChunkZ, int radius,
+                                     const ChunkReadyCallback& onChunkReady,
+                                     const std::atomic<bool>* cancel) {
+    // Everything below generates for this world, even if Regenerate runs meanwhile
+    const auto params = LoadParams();
+    
     // Asymmetric range to visually center the island (which generates at world 0,0)
     // Load one extra chunk on the negative side
+    std::vector<ChunkPos> missing;
     for (int x = centerChunkX - radius - 1; x <= centerChunkX + radius; x++) {
         for (int z = centerChunkZ - radius - 1; z <= centerChunkZ + radius; z++) {
-            GenerateChunk(x, z);
+            if (!FindLoaded({x, z})) {
+                missing.push_back({x, z});
+            }
+        }
+    }
+    if (missing.empty()) return true;
+    
+    // Nearest to the visual center first so the middle of the island streams in first
+    std::stable_sort(missing.begin(), missing.end(), [&](const ChunkPos& a, const ChunkPos& b) {
+        return DistanceSq(a, centerChunkX, centerChunkZ) < DistanceSq(b, centerChunkX, centerChunkZ);
+    });
+    
+    // Saved and cached chunks first: decoding is independent per chunk
+    std::vector<std::shared_ptr<const Chunk>> generated(missing.size());
+    std::vector<char> fromStore(missing.size(), 0);
+    ParallelFor(missing.size(), [&](std::size_t i) {
+        if (cancel && *cancel) return;
+        bool stored = false;
+        generated[i] = FindSavedOrCached(*params, missing[i], &stored);
+        fromStore[i] = stored;
+        if (generated[i] && onChunkReady) onChunkReady(*generated[i]);
+    });
+    if (cancel && *cancel) return false;
+    
+    // The rest are generated together, so neighbouring chunks share the
+    // decoration work
+    std::vector<ChunkPos> toBuild;
+    std::vector<std::size_t> buildSlots;
+    for (std::size_t i = 0; i < missing.size(); i++) {
+        if (!generated[i]) {
+            toBuild.push_back(missing[i]);
+            buildSlots.push_back(i);
+        }
+    }
+    if (!toBuild.empty()) {
+        auto built = BuildChunks(*params, toBuild, onChunkReady, cancel);
+        if (cancel && *cancel) return false;
+        for (std::size_t b = 0; b < built.size(); b++) {
+            generated[buildSlots[b]] = std::move(built[b]);
         }
     }
+    
+    // Commit step. A chunk an edit already loaded (and maybe changed) wins,
+    // and nothing is committed once the world has been regenerated.
+    for (std::size_t i = 0; i < missing.size(); i++) {
+        Shard& shard = ShardFor(missing[i]);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        if (LoadParams() != params) return false;
+        if (shard.chunks.Emplace(missing[i], std::move(generated[i])).second) {
+            shard.unsent.insert(missing[i]);
+            if (!fromStore[i]) shard.unsaved.insert(missing[i]);
+        }
+    }
+    return true;
+}
+
+void World::SetRegionStore(std::shared_ptr<RegionStore> store) {
+    std::atomic_store(&m_regions, std::move(store));
 }
 
-std::vector<const Chunk*> World::GetLoadedChunks() const {
-    std::vector<const Chunk*> chunks;
-    chunks.reserve(m_chunks.size());
+std::size_t World::SaveChunks() {
+    const auto store = std::atomic_load(&m_regions);
+    if (!store) return 0;
+    const auto params = LoadParams();
+    if (store->GetSeed() != params->seed || !(store->GetConfig() == params->config)) {
+        std::cerr << "Not saving chunks into the region store of another world" << std::endl;
+        return 0;
+    }
     
-    for (const auto& pair : m_chunks) {
-        chunks.push_back(pair.second.get());
+    // Snapshot what changed, then write without holding any shard. An edit
+    // after this copies the chunk (the snapshot shares it) and marks it again.
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        for (const ChunkPos& pos : shard.unsaved) {
+            if (const auto* chunk = shard.chunks.Find(pos)) {
+                chunks.push_back(*chunk);
+            }
+        }
+        shard.unsaved.clear();
+    }
+    if (chunks.empty()) return 0;
+    
+    if (!store->Save(chunks)) {
+        // Keep them for the next save
+        for (const auto& chunk : chunks) {
+            const ChunkPos pos{chunk->GetChunkX(), chunk->GetChunkZ()};
+            Shard& shard = ShardFor(pos);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            shard.unsaved.insert(pos);
+        }
+        return 0;
+    }
+    return chunks.size();
+}
+
+void World::MarkEdited(int x, int z) {
+    const int size = m_chunkSize;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            const ChunkPos pos = WorldToChunk(x + dx, z + dz, size);
+            MarkDirty(pos.x, pos.z);
+        }
+    }
+}
+
+void World::MarkDirty(int chunkX, int chunkZ) {
+    const ChunkPos pos{chunkX, chunkZ};
+    Shard& shard = ShardFor(pos);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.chunks.Find(pos)) {
+        shard.unsent.insert(pos);
+    }
+}
+
+void World::MarkAllDirty() {
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.chunks.ForEach([&](const ChunkPos& pos, const std::shared_ptr<const Chunk>&) {
+            shard.unsent.insert(pos);
+        });
+    }
+}
+
+void World::ClearDirty() {
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.unsent.clear();
+    }
+}
+
+std::size_t World::DirtyCount() const {
+    std::size_t count = 0;
+    for (Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        count += shard.unsent.size();
+    }
+    return count;
+}
+
+std::vector<ChunkPos> World::TakeDirtyChunks(int centerChunkX, int centerChunkZ, std::size_t maxCount) {
+    std::vector<ChunkPos> dirty;
+    for (Shard& shard : m_shards) {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        dirty.insert(dirty.end(), shard.unsent.begin(), shard.unsent.end());
+    }
+    
+    // Ties broken by position, so the order doesn't depend on the hash sets
+    const std::size_t count = (std::min)(maxCount, dirty.size());
+    std::partial_sort(dirty.begin(), dirty.begin() + count, dirty.end(), [&](const ChunkPos& a, const ChunkPos& b) {
+        const float da = DistanceSq(a, centerChunkX, centerChunkZ);
+        const float db = DistanceSq(b, centerChunkX, centerChunkZ);
+        if (da != db) return da < db;
+        return a.x != b.x ? a.x < b.x : a.z < b.z;
+    });
+    dirty.resize(count);
+    
+    // A mark made since the copy is dropped too: the caller sends these
+    // chunks as they are after this, edits included
+    for (const ChunkPos& pos : dirty) {
+        Shard& shard = ShardFor(pos);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.unsent.erase(pos);
+    }
+    return dirty;
+}
+
+std::vector<std::shared_ptr<const Chunk>> World::GetLoadedChunks() const {
+    // Hold every shard at once so the snapshot is one point in time. Writers
+    // only ever lock a single shard, so taking them in order can't deadlock.
+    std::vector<std::shared_lock<std::shared_mutex>> locks;
+    locks.reserve(SHARD_COUNT);
+    std::size_t count = 0;
+    for (Shard& shard : m_shards) {
+        locks.emplace_back(shard.mutex);
+        count += shard.chunks.Size();
+    }
+    
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    chunks.reserve(count);
+    for (const Shard& shard : m_shards) {
+        shard.chunks.ForEach([&](const ChunkPos&, const std::shared_ptr<const Chunk>& chunk) {
+            chunks.push_back(chunk);
+        });
     }
     
     return chunks;
 }
 
-ChunkPos World::WorldToChunk(int worldX, int worldZ) const {
-    int s = m_config.size;
+std::vector<std::shared_ptr<const Chunk>> World::GetChunksAround(int x, int z) const {
+    const int size = m_chunkSize;
+    std::vector<std::shared_ptr<const Chunk>> chunks;
+    for (int dz = -1; dz <= 1; dz++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            ChunkPos pos = WorldToChunk(x + dx, z + dz, size);
+            auto chunk = GetChunk(pos.x, pos.z);
+            if (chunk && std::find(chunks.begin(), chunks.end(), chunk) == chunks.end()) {
+                chunks.push_back(std::move(chunk));
+            }
+        }
+    }
+    return chunks;
+}
+
+RaycastHit World::Raycast(float ox, float oy, float oz, float dx, float dy, float dz, float maxDistance) const {
+    PROFILE_SCOPE("World::Raycast");
+    RaycastHit result;
+    // Also false for NaN
+    if (!(std::abs(ox) <= MAX_RAYCAST_COORD && std::abs(oy) <= MAX_RAYCAST_COORD &&
+          std::abs(oz) <= MAX_RAYCAST_COORD)) {
+        return result;
+    }
+    const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+    if (!(length > 0.0f) || !std::isfinite(length) || !(maxDistance > 0.0f)) return result;
+    // Further out, adding one block's step to t would round away and the
+    // walk would never end (nor stay inside int coordinates)
+    maxDistance = (std::min)(maxDistance, static_cast<float>(1 << 22));
+    dx /= length;
+    dy /= length;
+    dz /= length;
+
+    const int size = m_chunkSize.load(std::memory_order_relaxed);
+    const int height = LoadParams()->config.height;
+    constexpr float INF = std::numeric_limits<float>::infinity();
+
+    // Nothing to hit above or below the world: start where the ray enters
+    // its height range, e.g. a camera ray from high above
+    float t = 0.0f;
+    float tEnd = maxDistance;
+    bool enteredFromY = false;
+    if (dy != 0.0f) {
+        float tBottom = (0.0f - oy) / dy;
+        float tTop = (static_cast<float>(height) - oy) / dy;
+        if (tBottom > tTop) std::swap(tBottom, tTop);
+        if (tBottom > t) {
+            t = tBottom;
+            enteredFromY = true;
+        }
+        tEnd = (std::min)(tEnd, tTop);
+    } else if (oy < 0.0f || oy >= static_cast<float>(height)) {
+        return result;
+    }
+    if (t > tEnd) return result;
+
+    const float px = ox + dx * t, py = oy + dy * t, pz = oz + dz * t;
+    int x = static_cast<int>(std::floor(px));
+    int y = static_cast<int>(std::floor(py));
+    int z = static_cast<int>(std::floor(pz));
+    int normalX = 0, normalY = 0, normalZ = 0;
+    if (enteredFromY) {
+        y = dy < 0.0f ? height - 1 : 0;
+        normalY = dy < 0.0f ? 1 : -1;
+    }
+
+    // Ray distance to the next boundary on each axis, and between boundaries
+    const int stepX = dx > 0.0f ? 1 : -1;
+    const int stepY = dy > 0.0f ? 1 : -1;
+    const int stepZ = dz > 0.0f ? 1 : -1;
+    const float deltaX = dx != 0.0f ? 1.0f / std::abs(dx) : INF;
+    const float deltaY = dy != 0.0f ? 1.0f / std::abs(dy) : INF;
+    const float deltaZ = dz != 0.0f ? 1.0f / std::abs(dz) : INF;
+    float maxX = dx != 0.0f ? t + (dx > 0.0f ? x + 1 - px : px - x) * deltaX : INF;
+    float maxY = dy != 0.0f ? t + (dy > 0.0f ? y + 1 - py : py - y) * deltaY : INF;
+    float maxZ = dz != 0.0f ? t + (dz > 0.0f ? z + 1 - pz : pz - z) * deltaZ : INF;
+    if (enteredFromY) maxY = t + deltaY;
+
+    // The chunk under the ray, looked up again only when it crosses a border
+    std::shared_ptr<const Chunk> chunk;
+    ChunkPos chunkPos{0, 0};
+    bool looked = false;
+
+    while (y >= 0 && y < height) {
+        const ChunkPos pos = WorldToChunk(x, z, size);
+        if (!looked || !(pos == chunkPos)) {
+            chunk = FindLoaded(pos);
+            chunkPos = pos;
+            looked = true;
+        }
+        if (chunk) {
+            const int localX = x - pos.x * size;
+            const int localZ = z - pos.z * size;
+            // Above the column's top block is all Air
+            if (y <= chunk->GetTopY(localX, localZ)) {
+                const BlockType type = chunk->GetBlock(localX, y, localZ).type;
+                if (type != BlockType::Air) {
+                    result.hit = true;
+                    result.x = x;
+                    result.y = y;
+                    result.z = z;
+                    result.normalX = normalX;
+                    result.normalY = normalY;
+                    result.normalZ = normalZ;
+                    result.distance = t;
+                    result.type = type;
+                    return result;
+                }
+            }
+        }
+
+        // Step into whichever neighbour the ray reaches first
+        if (maxX < maxY && maxX < maxZ) {
+            if (maxX > tEnd) break;
+            t = maxX;
+            maxX += deltaX;
+            x += stepX;
+            normalX = -stepX; normalY = 0; normalZ = 0;
+        } else if (maxY < maxZ) {
+            if (maxY > tEnd) break;
+            t = maxY;
+            maxY += deltaY;
+            y += stepY;
+            normalX = 0; normalY = -stepY; normalZ = 0;
+        } else {
+            if (maxZ > tEnd) break;
+            t = maxZ;
+            maxZ += deltaZ;
+            z += stepZ;
+            normalX = 0; normalY = 0; normalZ = -stepZ;
+        }
+    }
+    return result;
+}
+
+ChunkPos World::WorldToChunk(int worldX, int worldZ, int size) {
+    int s = size;
     int chunkX = worldX >= 0 ? worldX / s : (worldX - s + 1) / s;
     int chunkZ = worldZ >= 0 ? worldZ / s : (worldZ - s + 1) / s;
     
     return {chunkX, chunkZ};
 }
 
-void World::WorldToLocal(int worldX, int worldZ, int& chunkX, int& chunkZ, int& localX, int& localZ) const {
-    ChunkPos pos = WorldToChunk(worldX, worldZ);
+void World::WorldToLocal(int worldX, int worldZ, int size, int& chunkX, int& chunkZ, int& localX, int& localZ) {
+    ChunkPos pos = WorldToChunk(worldX, worldZ, size);
     chunkX = pos.x;
     chunkZ = pos.z;
     
-    int s = m_config.size;
+    int s = size;
     localX = worldX - (chunkX * s);
     localZ = worldZ - (chunkZ * s);
     
@@ -1,72 +1,187 @@
 #pragma once
 
 #include "Chunk.h"
+#include "ChunkCache.h"
+#include "ChunkIndex.h"
+#include "RegionStore.h"
+#include "WorldTypes.h"
+#include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
-#include <unordered_map>
+#include <shared_mutex>
+#include <unordered_set>
 #include <vector>
 
 namespace OreForged {
 
-struct WorldConfig {
-    int size = 32;    // Standard chunk size (32x32)
-    int height = 32;  // Increased height for better terrain
-    float oreMult = 1.0f;
-    float treeMult = 1.0f;
-    float islandFactor = 1.0f; // Scales island radius within chunk size
-    // float damageMult stored/handled in App.tsx? No, maybe World needs to know for Block Health?
-    // Actually Block Health is handled in UI for now (VoxelRenderer/App).
-    // So WorldConfig just needs generation params.
-};
-
-// Hash function for chunk coordinates
-struct ChunkPos {
-    int x, z;
-    
-    bool operator==(const ChunkPos& other) const {
-        return x == other.x && z == other.z;
-    }
-};
+// World::Raycast ignores rays starting farther than this from 0 on any
+// axis: past 2^24, floats no longer tell neighbouring blocks apart
+constexpr float MAX_RAYCAST_COORD = static_cast<float>(1 << 24);
 
-struct ChunkPosHash {
-    std::size_t operator()(const ChunkPos& pos) const {
-        return std::hash<int>()(pos.x) ^ (std::hash<int>()(pos.z) << 1);
-    }
+// What World::Raycast found. The normal points out of the face the ray
+// entered the block through (all zero if the ray started inside it).
+struct RaycastHit {
+    bool hit = false;
+    int x = 0, y = 0, z = 0;
+    int normalX = 0, normalY = 0, normalZ = 0;
+    float distance = 0.0f; // Along the ray, in blocks
+    BlockType type = BlockType::Air;
 };
 
+// Thread-safe. Loaded chunks live in shards, each behind its own reader/writer
+// lock, so generation can commit chunks while gameplay reads and edits.
+// Chunks are handed out as shared_ptr snapshots: an edit to a chunk that
+// anyone else still holds (a snapshot, the cache) copies it first, so a
+// snapshot never changes underneath its reader.
+//
+// Each thread remembers the last chunk GetBlock found (pinned, so edits by
+// others copy it rather than change it). Replacing or dropping any loaded
+// chunk moves the world to a new epoch, which invalidates those.
 class World {
 public:
-    World(uint32_t seed = 12345);
+    // Worlds built one after another (e.g. a regen's staging world) can share
+    // a chunk cache; by default each world gets its own
+    explicit World(uint32_t seed = 12345, std::shared_ptr<ChunkCache> cache = nullptr);
     
     // Get block at world coordinates
     Block GetBlock(int x, int y, int z) const;
     void SetBlock(int x, int y, int z, BlockType type);
     
-    // Chunk management
-    Chunk* GetChunk(int chunkX, int chunkZ);
-    const Chunk* GetChunk(int chunkX, int chunkZ) const;
+    // Snapshot of a loaded chunk. A chunk that is saved but not loaded yet is
+    // loaded now; null if it is neither.
+    std::shared_ptr<const Chunk> GetChunk(int chunkX, int chunkZ) const;
     
     void GenerateChunk(int chunkX, int chunkZ);
-    void LoadChunksAroundPosition(int centerChunkX, int centerChunkZ, int radius);
     
-    // Get all loaded chunks for rendering
-    std::vector<const Chunk*> GetLoadedChunks() const;
+    // Called from generation workers as each chunk finishes, before it is
+    // inserted into the world. Must be thread-safe.
+    using ChunkReadyCallback = std::function<void(const Chunk&)>;
+    
+    // Loads (from the region store) or generates any missing chunks in the
+    // radius in parallel (nearest to the center first), then inserts them. Setting `cancel` stops the workers
+    // after their current chunk; nothing is inserted then. Returns false if
+    // cancelled.
+    bool LoadChunksAroundPosition(int centerChunkX, int centerChunkZ, int radius,
+                                  const ChunkReadyCallback& onChunkReady = nullptr,
+                                  const std::atomic<bool>* cancel = nullptr);
+    
+    // Get all loaded chunks for rendering: one consistent snapshot, taken
+    // with every shard locked
+    std::vector<std::shared_ptr<const Chunk>> GetLoadedChunks() const;
     
-    uint32_t GetSeed() const { return m_seed; }
+    // Loaded chunks whose faces can depend on the block column at (x, z):
+    // its own chunk plus whichever neighbours that column borders
+    std::vector<std::shared_ptr<const Chunk>> GetChunksAround(int x, int z) const;
     
-    // Regenerate world with new seed and config
+    // First non-Air block along the ray from (ox, oy, oz) in direction
+    // (dx, dy, dz) (need not be normalized), within maxDistance. Block
+    // (x, y, z) spans [x, x + 1) on each axis. Walks the voxel grid one
+    // block at a time (Amanatides & Woo), so the cost grows with distance
+    // only; chunks that aren't loaded count as empty. Rays that aren't
+    // finite or start beyond MAX_RAYCAST_COORD on an axis hit nothing.
+    RaycastHit Raycast(float ox, float oy, float oz, float dx, float dy, float dz, float maxDistance) const;
+    
+    uint32_t GetSeed() const { return LoadParams()->seed; }
+    
+    // Regenerate world with new seed and config. Chunks generated or edits
+    // made for the previous world after this point are dropped. Detaches the
+    // region store, whose chunks belong to the previous world.
     void Regenerate(uint32_t seed, const WorldConfig& config);
     
-    const WorldConfig& GetConfig() const { return m_config; }
+    WorldConfig GetConfig() const { return LoadParams()->config; }
+    
+    // Generated chunks are kept across regenerations, so revisiting a
+    // seed/config skips Chunk::Generate
+    void SetCacheBudget(std::size_t bytes) { m_cache->SetBudget(bytes); }
+    const ChunkCache& GetCache() const { return *m_cache; }
+    std::shared_ptr<ChunkCache> GetSharedCache() const { return m_cache; }
+    
+    // Saved chunks of this world (same seed and config). Missing chunks are
+    // read from the store before falling back to generation, and SaveChunks
+    // writes back what changed since.
+    void SetRegionStore(std::shared_ptr<RegionStore> store);
+    std::shared_ptr<RegionStore> GetRegionStore() const { return std::atomic_load(&m_regions); }
+    
+    // Writes every chunk generated or edited since the last save to the
+    // region store. Returns the number of chunks written.
+    std::size_t SaveChunks();
+    
+    // Dirty chunks: loaded chunks the UI hasn't been sent as they are now.
+    // Every chunk is dirty when loaded. Edits are marked by MarkEdited, so
+    // callers that patch the UI some other way (block deltas) can skip it.
+    
+    // Marks the chunks an edit to column (x, z) shows up in: its own, plus
+    // the neighbours whose border faces it touches (see GetChunksAround)
+    void MarkEdited(int x, int z);
+    void MarkDirty(int chunkX, int chunkZ);
+    void MarkAllDirty(); // e.g. for a UI that starts over
+    void ClearDirty();   // e.g. once a staged copy of every chunk went out
+    std::size_t DirtyCount() const;
+    
+    // Up to maxCount dirty chunks, nearest to the center chunk first, which
+    // are no longer marked
+    std::vector<ChunkPos> TakeDirtyChunks(int centerChunkX, int centerChunkZ, std::size_t maxCount);
 
 private:
-    uint32_t m_seed;
-    WorldConfig m_config;
-    std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> m_chunks;
-    
-    // Convert world coordinates to chunk coordinates
-    // Now instance methods to access m_config.size
-    ChunkPos WorldToChunk(int worldX, int worldZ) const;
-    void WorldToLocal(int worldX, int worldZ, int& chunkX, int& chunkZ, int& localX, int& localZ) const;
+    // Seed and config of the current world. Replaced (never modified) by
+    // Regenerate, so the pointer also identifies the world generation.
+    struct Params {
+        uint32_t seed;
+        WorldConfig config;
+    };
+    
+    // Shards are picked by the top bits of the hash; ChunkIndex uses the low ones
+    static constexpr int SHARD_BITS = 4;
+    static constexpr std::size_t SHARD_COUNT = std::size_t(1) << SHARD_BITS;
+    
+    struct Shard {
+        std::shared_mutex mutex;
+        ChunkIndex<std::shared_ptr<const Chunk>> chunks;
+        std::unordered_set<ChunkPos, ChunkPosHash> unsaved; // Differ from the region store
+        std::unordered_set<ChunkPos, ChunkPosHash> unsent;  // Differ from what the UI was sent
+    };
+    
+    std::shared_ptr<const Params> m_params; // Accessed with std::atomic_load/store
+    std::atomic<int> m_chunkSize; // m_params->config.size, for lock-free coordinate math
+    mutable std::array<Shard, SHARD_COUNT> m_shards; // GetChunk inserts chunks it loads
+    std::shared_ptr<ChunkCache> m_cache;
+    std::shared_ptr<RegionStore> m_regions; // Accessed with std::atomic_load/store; may be null
+    std::atomic<uint64_t> m_epoch; // Unique across all worlds, see above
+    
+    std::shared_ptr<const Params> LoadParams() const;
+    void NextEpoch();
+    Shard& ShardFor(const ChunkPos& pos) const;
+    
+    // Loaded chunk, without consulting the region store
+    std::shared_ptr<const Chunk> FindLoaded(const ChunkPos& pos) const;
+    
+    // Saved chunk from the region store, or a cached one for this
+    // seed/config, or null. `fromStore` tells whether the chunk matches its
+    // saved version. Thread-safe; does not touch the shards.
+    std::shared_ptr<const Chunk> FindSavedOrCached(const Params& params, const ChunkPos& pos,
+                                                   bool* fromStore = nullptr);
+    
+    // FindSavedOrCached, or else a freshly generated chunk (see BuildChunks)
+    std::shared_ptr<const Chunk> LoadOrGenerateChunk(const Params& params, const ChunkPos& pos,
+                                                     bool* fromStore = nullptr);
+    
+    // Generates and caches chunks, in two phases so trees are never cut off
+    // at chunk borders. First every chunk within one of a requested position
+    // is generated, collecting the leaves it spills over its edges (from the
+    // cache if a neighbour's spill is known already). Then each requested
+    // chunk takes in its eight neighbours' spills.
+    // Phases overlap: a chunk is finished (and reported to `onChunkReady`)
+    // as soon as its neighbourhood is done. The result is a function of
+    // seed, config and position alone, whatever else is loaded or built with
+    // it. Entries are null if cancelled. Thread-safe; does not touch the shards.
+    std::vector<std::shared_ptr<const Chunk>> BuildChunks(const Params& params, const std::vector<ChunkPos>& positions,
+                                                          const ChunkReadyCallback& onChunkReady = nullptr,
+                                                          const std::atomic<bool>* cancel = nullptr);
+    
+    // Convert world coordinates to chunk coordinates for a given chunk size
+    static ChunkPos WorldToChunk(int worldX, int worldZ, int size);
+    static void WorldToLocal(int worldX, int worldZ, int size, int& chunkX, int& chunkZ, int& localX, int& localZ);
 };
 
 } // namespace OreForged
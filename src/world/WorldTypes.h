@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace OreForged {
+
+// Upper bounds for a world's dimensions; the progression never gets near them
+constexpr int MAX_CHUNK_SIZE = 128;
+constexpr int MAX_WORLD_HEIGHT = 256;
+
+struct WorldConfig {
+    int size = 32;    // Standard chunk size (32x32)
+    int height = 32;  // Increased height for better terrain
+    float oreMult = 1.0f;
+    float treeMult = 1.0f;
+    float islandFactor = 1.0f; // Scales island radius within chunk size
+    // float damageMult stored/handled in App.tsx? No, maybe World needs to know for Block Health?
+    // Actually Block Health is handled in UI for now (VoxelRenderer/App).
+    // So WorldConfig just needs generation params.
+
+    // Every generation input; keep in sync with ChunkKeyHash when adding fields
+    bool operator==(const WorldConfig& other) const {
+        return size == other.size && height == other.height &&
+               oreMult == other.oreMult && treeMult == other.treeMult &&
+               islandFactor == other.islandFactor;
+    }
+
+    // Dimensions in range and generation multipliers finite and non-negative
+    bool IsValid() const {
+        return size >= 1 && size <= MAX_CHUNK_SIZE && height >= 1 && height <= MAX_WORLD_HEIGHT &&
+               std::isfinite(oreMult) && oreMult >= 0.0f && std::isfinite(treeMult) && treeMult >= 0.0f &&
+               std::isfinite(islandFactor) && islandFactor >= 0.0f;
+    }
+};
+
+// Hash function for chunk coordinates
+struct ChunkPos {
+    int x, z;
+
+    bool operator==(const ChunkPos& other) const {
+        return x == other.x && z == other.z;
+    }
+};
+
+// Both coordinates packed into 64 bits and mixed (MurmurHash3's finalizer),
+// so every output bit depends on every input bit. Grids around the origin,
+// where x and z are small and often equal or mirrored, spread evenly over
+// both the high bits (World's shard) and the low bits (table slots).
+struct ChunkPosHash {
+    std::size_t operator()(const ChunkPos& pos) const {
+        uint64_t h = (static_cast<uint64_t>(static_cast<uint32_t>(pos.x)) << 32) | static_cast<uint32_t>(pos.z);
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return static_cast<std::size_t>(h);
+    }
+};
+
+} // namespace OreForged
@@ -0,0 +1,214 @@
+// ParseIntArgs / ParseIntList (the bindings' fast path) against
+// ParseIntListJson (the full JSON fallback): wherever the fast path accepts
+// a request, both must read the same integers.
+
+#include "core/BindingArgs.h"
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace OreForged;
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            g_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+std::string Show(const std::vector<int>& values) {
+    std::string text = "[";
+    for (std::size_t i = 0; i < values.size(); i++) {
+        text += (i ? "," : "") + std::to_string(values[i]);
+    }
+    return text + "]";
+}
+
+// The fast path may turn a request down, but must never disagree with the
+// fallback on one it accepts
+void CheckAgrees(const std::string& req) {
+    std::vector<int> fast, slow;
+    const bool fastOk = ParseIntList(req, fast);
+    const bool slowOk = ParseIntListJson(req, slow);
+    if (fastOk && (!slowOk || fast != slow)) {
+        std::fprintf(stderr, "disagree on %s: fast %s, fallback %s\n", req.c_str(), Show(fast).c_str(),
+                     slowOk ? Show(slow).c_str() : "error");
+        g_failures++;
+    }
+
+    int args[4];
+    const bool argsOk = ParseIntArgs(req, args, 4);
+    if (argsOk != (fastOk && fast.size() >= 4) ||
+        (argsOk && std::vector<int>(args, args + 4) != std::vector<int>(fast.begin(), fast.begin() + 4))) {
+        std::fprintf(stderr, "ParseIntArgs and ParseIntList disagree on %s\n", req.c_str());
+        g_failures++;
+    }
+}
+
+// `fast` / `slow`: expected lists, or null where that path must fail
+void Case(const std::string& req, const std::vector<int>* fast, const std::vector<int>* slow) {
+    std::vector<int> out;
+    const bool fastOk = ParseIntList(req, out);
+    if (fastOk != (fast != nullptr) || (fast && out != *fast)) {
+        std::fprintf(stderr, "ParseIntList(%s): got %s\n", req.c_str(), fastOk ? Show(out).c_str() : "false");
+        g_failures++;
+    }
+    const bool slowOk = ParseIntListJson(req, out);
+    if (slowOk != (slow != nullptr) || (slow && out != *slow)) {
+        std::fprintf(stderr, "ParseIntListJson(%s): got %s\n", req.c_str(), slowOk ? Show(out).c_str() : "false");
+        g_failures++;
+    }
+    CheckAgrees(req);
+}
+
+void Both(const std::string& req, const std::vector<int>& expected) {
+    Case(req, &expected, &expected);
+}
+
+void FallbackOnly(const std::string& req, const std::vector<int>& expected) {
+    Case(req, nullptr, &expected);
+}
+
+void Neither(const std::string& req) {
+    Case(req, nullptr, nullptr);
+}
+
+void TestForms() {
+    Both("[1,2,3,4]", {1, 2, 3, 4});
+    Both("[-17,12,305,3]", {-17, 12, 305, 3});
+    Both("[]", {});
+    Both("[1,2,3,4,5,6,7,8]", {1, 2, 3, 4, 5, 6, 7, 8});
+    Both("[2147483647,-2147483648,0,-0]", {2147483647, -2147483648, 0, 0});
+
+    // Older UI code
+    Both("[\"[1,2,3,4]\"]", {1, 2, 3, 4});
+    Both("[\" [ 5 , 6 ] \"]", {5, 6});
+    Both("[\"1\",\"-2\",\" 3 \",4]", {1, -2, 3, 4});
+
+    // JSON whitespace anywhere between tokens
+    Both(" [ 1 ,\t2,\n3 ,\r4 ] ", {1, 2, 3, 4});
+    Both("\n[\n1\n,\n2\n]\n", {1, 2});
+}
+
+void TestFallbackOnly() {
+    // Floats and exponents are truncated by the fallback only
+    FallbackOnly("[1.5,2,3,4]", {1, 2, 3, 4});
+    FallbackOnly("[-1.5,2,3,4]", {-1, 2, 3, 4});
+    FallbackOnly("[1e3,2,3,4]", {1000, 2, 3, 4});
+    FallbackOnly("[1E2,2,3,4]", {100, 2, 3, 4});
+    // Escapes, and strings that aren't integers (read as 0)
+    FallbackOnly("[\"\\u0031\",2,3,4]", {1, 2, 3, 4});
+    FallbackOnly("[\"abc\",2,3,4]", {0, 2, 3, 4});
+    FallbackOnly("[\"01\",2]", {1, 2});
+    FallbackOnly("[true,null,3,4]", {0, 0, 3, 4});
+    // The first string is the whole list, whatever follows it
+    FallbackOnly("[\"[1,2]\",3]", {1, 2});
+}
+
+void TestRejected() {
+    // Out of int range: the fallback refuses rather than wrapping
+    Neither("[2147483648,0,0,0]");
+    Neither("[-2147483649,0,0,0]");
+    Neither("[18446744073709551616,0,0,0]");
+    Neither("[1e10,0,0,0]");
+    // Malformed JSON
+    Neither("[1,2,3,4]x");
+    Neither("[1,2,3,4],");
+    Neither("[1,2,3,4,]");
+    Neither("[1,,2]");
+    Neither("[01,2,3,4]");
+    Neither("[-,2]");
+    Neither("[+1,2]");
+    Neither("[1,2");
+    Neither("[\"1,2]");
+    Neither("[\"");
+    Neither("");
+    Neither("1,2,3,4");
+    Neither("{\"x\":1}");
+    Neither("\"[1,2,3,4]\"");
+}
+
+void TestArgsCount() {
+    int args[4] = {9, 9, 9, 9};
+    CHECK(!ParseIntArgs("[1,2,3]", args, 4));
+    CHECK(ParseIntArgs("[1,2,3,4,5]", args, 4));
+    CHECK(args[0] == 1 && args[3] == 4);
+    CHECK(ParseIntArgs("[\"[7,8]\"]", args, 2));
+    CHECK(args[0] == 7 && args[1] == 8);
+}
+
+// interactBatch's forms: actions nested or flat, capped
+void TestActions() {
+    std::vector<int> out;
+    CHECK(ParseIntListJson("[[1,2,3,4],[5,6,7,8]]", out, 4));
+    CHECK(out == std::vector<int>({1, 2, 3, 4, 5, 6, 7, 8}));
+    // Short actions are skipped, long ones cut, floats truncated
+    CHECK(ParseIntListJson("[[1,2,3],[5.9,6,7,8,9],[\"1\",2,{\"a\":[3]},[4]]]", out, 4));
+    CHECK(out == std::vector<int>({5, 6, 7, 8, 1, 2, 0, 0}));
+    // A flat list of numbers the fast path turns down
+    CHECK(ParseIntListJson("[1.5,9,0,1]", out, 4));
+    CHECK(out == std::vector<int>({1, 9, 0, 1}));
+    CHECK(ParseIntListJson("[\"[[1,2,3,4]]\"]", out, 4));
+    CHECK(out == std::vector<int>({1, 2, 3, 4}));
+    CHECK(!ParseIntListJson("[[1,2,3,4]", out, 4));
+    CHECK(!ParseIntListJson("[[1,2,3,4e10]]", out, 4));
+
+    // Past the cap, both stop reading: what follows isn't even parsed
+    CHECK(ParseIntList("[1,2,3,4,5,6,7,8,9", out, 8));
+    CHECK(out.size() == 9);
+    CHECK(ParseIntListJson("[1,2,3,4,5.5,6,7,8,9 garbage", out, 4, 8));
+    CHECK(out.size() == 9);
+    CHECK(ParseIntListJson("[[1,2,3,4],[5,6,7,8],[9,9,9,9]", out, 4, 8));
+    CHECK(out.size() == 9);
+    CHECK(ParseIntListJson("[\"[1,2,3,4,5,6,7,8,9]\"]", out, 4, 8));
+    CHECK(out.size() == 9);
+    // At the cap is fine
+    CHECK(ParseIntList("[1,2,3,4,5,6,7,8]", out, 8));
+    CHECK(out.size() == 8);
+    CHECK(ParseIntListJson("[[1,2,3,4],[5,6,7,8]]", out, 4, 8));
+    CHECK(out.size() == 8);
+}
+
+// Random requests built from the characters that matter to both parsers
+void TestRandomAgreement() {
+    const std::string alphabet = "[]\",0123456789- .e\\";
+    const std::vector<std::string> pieces = {"[", "]", ",", "\"", "1", "-2", "30", "0", " ", ".5", "e2", "\"[", "]\""};
+    std::mt19937 rng(12345);
+    for (int i = 0; i < 200000; i++) {
+        std::string req = "[";
+        const int length = static_cast<int>(rng() % 12);
+        for (int j = 0; j < length; j++) {
+            if (rng() % 2) {
+                req += alphabet[rng() % alphabet.size()];
+            } else {
+                req += pieces[rng() % pieces.size()];
+            }
+        }
+        if (rng() % 2) req += "]";
+        CheckAgrees(req);
+    }
+}
+
+} // namespace
+
+int main() {
+    TestForms();
+    TestFallbackOnly();
+    TestRejected();
+    TestArgsCount();
+    TestActions();
+    TestRandomAgreement();
+
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::printf("BindingArgsTest: all passed\n");
+    return 0;
+}
@@ -0,0 +1,144 @@
+// World under the game's threading: edits, chunk loads, block reads and the
+// dirty-chunk sender all at once. Checks that no edit is lost, and that
+// the last copy of every chunk taken from the dirty set matches the chunk
+// as it ends up. Build with -fsanitize=thread to check for data races too.
+
+#include "world/World.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace OreForged;
+
+namespace {
+
+int g_failures = 0;
+
+#define CHECK(cond)                                                                   \
+    do {                                                                              \
+        if (!(cond)) {                                                                \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            g_failures++;                                                             \
+        }                                                                             \
+    } while (0)
+
+constexpr int EDITORS = 2;
+constexpr int ROUNDS = 6;
+constexpr int EDIT_Y = 20;
+constexpr int EDIT_SPAN = 40; // Columns -20..19 on both axes, across chunk borders
+
+// Editor `e` owns the columns with (x + z) % EDITORS == e, so every block's
+// final type is known: the one its owner wrote in the last round
+BlockType EditType(int round) {
+    return round % 2 == 0 ? BlockType::Stone : BlockType::Dirt;
+}
+
+struct ChunkPosLess {
+    bool operator()(const ChunkPos& a, const ChunkPos& b) const {
+        return a.x != b.x ? a.x < b.x : a.z < b.z;
+    }
+};
+
+std::vector<uint8_t> Blocks(const Chunk& chunk) {
+    std::vector<uint8_t> blocks(static_cast<std::size_t>(chunk.GetSize()) * chunk.GetSize() * chunk.GetHeight());
+    chunk.CopyBlocks(blocks.data());
+    return blocks;
+}
+
+void TestConcurrentEditsLoadsAndSends() {
+    World world(4242);
+    std::atomic<int> editorsLeft{EDITORS};
+
+    // What the sender last took for each chunk, like a UI would have it
+    std::map<ChunkPos, std::shared_ptr<const Chunk>, ChunkPosLess> sent;
+    auto send = [&](const std::vector<ChunkPos>& positions) {
+        for (const ChunkPos& pos : positions) {
+            if (auto chunk = world.GetChunk(pos.x, pos.z)) sent[pos] = std::move(chunk);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int e = 0; e < EDITORS; e++) {
+        threads.emplace_back([&, e]() {
+            for (int round = 0; round < ROUNDS; round++) {
+                for (int x = -EDIT_SPAN / 2; x < EDIT_SPAN / 2; x++) {
+                    for (int z = -EDIT_SPAN / 2; z < EDIT_SPAN / 2; z++) {
+                        if (((x + z) % EDITORS + EDITORS) % EDITORS != e) continue;
+                        world.SetBlock(x, EDIT_Y, z, EditType(round));
+                        world.MarkEdited(x, z);
+                    }
+                    std::this_thread::yield(); // Let the sender in mid-round, even on one core
+                }
+            }
+            editorsLeft--;
+        });
+    }
+    threads.emplace_back([&]() {
+        // Loads overlap the edits: some chunks are generated by SetBlock first
+        for (int radius = 0; radius <= 3; radius++) {
+            world.LoadChunksAroundPosition(0, 0, radius);
+        }
+        for (int i = -5; i <= 5; i++) world.GenerateChunk(i, 4);
+    });
+    threads.emplace_back([&]() {
+        std::size_t blocks = 0;
+        while (editorsLeft > 0) {
+            for (const auto& chunk : world.GetLoadedChunks()) blocks += chunk->GetTopY(0, 0) >= 0;
+            for (int x = -EDIT_SPAN / 2; x < EDIT_SPAN / 2; x += 7) {
+                blocks += world.GetBlock(x, EDIT_Y, -x).type != BlockType::Air;
+            }
+        }
+        CHECK(blocks > 0);
+    });
+
+    // The sender: this thread, a few chunks at a time like PushDirtyChunks
+    std::size_t sentDuringEdits = 0;
+    while (editorsLeft > 0) {
+        const auto dirty = world.TakeDirtyChunks(0, 0, 8);
+        send(dirty);
+        if (editorsLeft > 0) sentDuringEdits += dirty.size();
+        std::this_thread::yield();
+    }
+    for (auto& t : threads) t.join();
+    CHECK(sentDuringEdits > 0);
+    send(world.TakeDirtyChunks(0, 0, SIZE_MAX));
+    CHECK(world.DirtyCount() == 0);
+
+    const BlockType last = EditType(ROUNDS - 1);
+    int lost = 0;
+    for (int x = -EDIT_SPAN / 2; x < EDIT_SPAN / 2; x++) {
+        for (int z = -EDIT_SPAN / 2; z < EDIT_SPAN / 2; z++) {
+            if (world.GetBlock(x, EDIT_Y, z).type != last) lost++;
+        }
+    }
+    if (lost > 0) std::fprintf(stderr, "%d edits lost\n", lost);
+    CHECK(lost == 0);
+
+    // Every loaded chunk went out at least once, and its last send is current
+    const auto loaded = world.GetLoadedChunks();
+    CHECK(loaded.size() == 8 * 8 + 11); // Chunks -4..3 on both axes, plus the row at z = 4
+    int stale = 0;
+    for (const auto& chunk : loaded) {
+        auto it = sent.find(ChunkPos{chunk->GetChunkX(), chunk->GetChunkZ()});
+        if (it == sent.end() || Blocks(*it->second) != Blocks(*chunk)) stale++;
+    }
+    if (stale > 0) std::fprintf(stderr, "%d chunks never sent as they are now\n", stale);
+    CHECK(stale == 0);
+}
+
+} // namespace
+
+int main() {
+    TestConcurrentEditsLoadsAndSends();
+
+    if (g_failures > 0) {
+        std::fprintf(stderr, "%d failure(s)\n", g_failures);
+        return 1;
+    }
+    std::printf("WorldConcurrencyTest: all passed\n");
+    return 0;
+}
@@ -74,7 +74,7 @@ function App() {
                         currentTool={currentTool}
                         isToolBroken={stats.isToolBroken}
                         damageMultiplier={stats.damageMultiplier}
-                        onResourceCollected={(type, count) => bridge.call('interact', [type, count])}
+                        onResourceCollected={(type, _count, pos) => bridge.mine(pos.x, pos.y, pos.z, type)}
                         onWorldUpdate={setWorldStats}
                         externalShakeTrigger={shakeTrigger} // Use one-shot state
                         cameraResetTrigger={0}
@@ -2,6 +2,8 @@ import { createFacet, Facet, WritableFacet } from '@react-facet/core';
 
 class FacetManager {
     private facets = new Map<string, WritableFacet<any>>();
+    // Patch facet id -> facet its partial objects are merged into
+    private patches = new Map<string, string>();
 
     getFacet<T>(id: string, initialValue: T): Facet<T> {
         if (!this.facets.has(id)) {
@@ -10,10 +12,19 @@ class FacetManager {
         return this.facets.get(id)!;
     }
 
+    // Updates to `patchId` carry only changed keys of the object in `targetId`
+    mergeInto(patchId: string, targetId: string) {
+        this.patches.set(patchId, targetId);
+    }
+
     updateFacet(id: string, value: any) {
         console.log(`Facet Update: ${id}`, typeof value === 'object' ? JSON.stringify(value).substring(0, 100) : value);
         try {
-            if (this.facets.has(id)) {
+            const target = this.patches.get(id);
+            if (target) {
+                const facet = this.getFacet<Record<string, unknown>>(target, {}) as WritableFacet<Record<string, unknown>>;
+                facet.set({ ...(facet.get() as Record<string, unknown>), ...value });
+            } else if (this.facets.has(id)) {
                 this.facets.get(id)!.set(value);
             } else {
                 console.log(`Creating new facet: ${id}`);
@@ -43,18 +54,67 @@ const call = (name: string, args: any[]) => {
     return Promise.resolve();
 };
 
+// The game's answer to a raycast call (see World::Raycast)
+export interface RaycastResult {
+    hit: boolean;
+    x: number;
+    y: number;
+    z: number;
+    normal: [number, number, number];
+    distance: number;
+    type: number;
+}
+
+// Mining actions from one event handler (a hit plus its splash) go out
+// together as a single interactBatch call, at most MAX_INTERACT_BATCH each
+const MAX_INTERACT_BATCH = 256;
+let pendingMines: number[] = [];
+
+const flushMines = () => {
+    const actions = pendingMines;
+    pendingMines = [];
+    if (actions.length === 4) {
+        call('interact', actions);
+        return;
+    }
+    for (let i = 0; i < actions.length; i += MAX_INTERACT_BATCH * 4) {
+        call('interactBatch', actions.slice(i, i + MAX_INTERACT_BATCH * 4));
+    }
+};
+
 export const bridge = {
     call,
+    mine: (x: number, y: number, z: number, blockType: number) => {
+        if (pendingMines.length === 0) queueMicrotask(flushMines);
+        pendingMines.push(x, y, z, blockType);
+    },
     uiReady: () => {
         if ((window as any).uiReady) {
             (window as any).uiReady();
         }
     },
+    // First block along a world-space ray, picked by the game. Null when
+    // there is no native side to ask (browser dev builds).
+    raycast: async (origin: { x: number, y: number, z: number }, direction: { x: number, y: number, z: number }, maxDistance?: number): Promise<RaycastResult | null> => {
+        if (!(window as any).raycast) return null;
+        const args = [origin.x, origin.y, origin.z, direction.x, direction.y, direction.z];
+        if (maxDistance !== undefined) args.push(maxDistance);
+        return call('raycast', args);
+    },
     regenerateWorld: async (seed: number, size?: number, height?: number, oreMult?: number, treeMult?: number, islandFactor?: number) => {
         const args = [seed, size || 21, height || 32, oreMult || 1.0, treeMult || 1.0, islandFactor || 1.0];
         console.log("Bridge regenerating world:", args);
         return call('regenerateWorld', args);
     },
+    // Flow control for regeneration: one ack per processed staged_chunk_data
+    // or staged_chunk_mesh payload
+    chunkAck: (chunkX?: number, chunkZ?: number) => {
+        return call('chunkAck', [chunkX, chunkZ]);
+    },
+    // Internal switch: C++ greedy meshes (chunk_mesh) instead of block IDs
+    setNativeMeshing: async (enabled: boolean) => {
+        return call('setNativeMeshing', [enabled]);
+    },
     quitApplication: async () => {
         return call('quitApplication', []);
     }
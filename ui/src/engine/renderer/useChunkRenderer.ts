@@ -1,15 +1,46 @@
 import { useRef, useEffect } from 'react';
 import * as THREE from 'three';
-import { ChunkMesh, ChunkData } from '../../game/ChunkMesh';
+import { ChunkMesh, ChunkData, ChunkMaterials } from '../../game/ChunkMesh';
+import { decodeChunk, decodeChunkMesh } from '../../game/ChunkCodec';
 import { remoteFacet } from '../hooks';
+import { bridge } from '../bridge';
 import { BLOCKS_TEXTURE } from '../../game/blocks_texture';
 
+// Where a chunk payload goes: the live chunks in the scene, or a regen's
+// staging set, built off-screen until world_swap
+interface ChunkTarget {
+    chunks: Map<string, ChunkMesh>;
+    parent: THREE.Object3D;
+}
+
+interface Staging {
+    generation: number | null;
+    chunks: Map<string, ChunkMesh>;
+    group: THREE.Group; // Never added to the scene
+}
+
+function chunkFor(target: ChunkTarget, chunkX: number, chunkZ: number): ChunkMesh {
+    const key = `${chunkX},${chunkZ}`;
+    let chunkMesh = target.chunks.get(key);
+    if (!chunkMesh) {
+        chunkMesh = new ChunkMesh(chunkX, chunkZ);
+        target.chunks.set(key, chunkMesh);
+    }
+    return chunkMesh;
+}
+
 export function useChunkRenderer(scene: THREE.Scene | null) {
     const chunksRef = useRef<Map<string, ChunkMesh>>(new Map());
-    const materialRef = useRef<THREE.Material | null>(null);
+    const materialsRef = useRef<ChunkMaterials | null>(null);
+    const stagingRef = useRef<Staging>({ generation: null, chunks: new Map(), group: new THREE.Group() });
 
-    const chunkDataFacet = remoteFacet<ChunkData | null>('chunk_data', null);
-    const clearChunksFacet = remoteFacet<string | null>('clear_chunks', null);
+    const chunkDataFacet = remoteFacet<ChunkData | string | null>('chunk_data', null);
+    const chunkMeshFacet = remoteFacet<string | null>('chunk_mesh', null);
+    const stagedChunkDataFacet = remoteFacet<ChunkData | string | null>('staged_chunk_data', null);
+    const stagedChunkMeshFacet = remoteFacet<string | null>('staged_chunk_mesh', null);
+    const worldStagingFacet = remoteFacet<number | null>('world_staging', null);
+    const worldSwapFacet = remoteFacet<number | null>('world_swap', null);
+    const blockUpdatesFacet = remoteFacet<number[] | null>('block_updates', null);
 
     // 1. Initialize Material & Texture
     useEffect(() => {
@@ -107,55 +138,208 @@ export function useChunkRenderer(scene: THREE.Scene | null) {
             );
         };
 
-        materialRef.current = material;
+        // Native meshes: same shading, but the atlas tile comes from a vertex
+        // attribute so UVs can repeat across merged quads
+        const tiledMaterial = material.clone();
+        tiledMaterial.onBeforeCompile = (shader, renderer) => {
+            material.onBeforeCompile(shader, renderer);
+
+            shader.vertexShader = shader.vertexShader.replace(
+                '#include <common>',
+                `#include <common>
+                attribute vec2 tile;
+                varying vec2 vTile;`
+            );
+
+            shader.vertexShader = shader.vertexShader.replace(
+                '#include <worldpos_vertex>',
+                `#include <worldpos_vertex>
+                vTile = tile;`
+            );
+
+            shader.fragmentShader = shader.fragmentShader.replace(
+                '#include <common>',
+                `#include <common>
+                varying vec2 vTile;`
+            );
+
+            shader.fragmentShader = shader.fragmentShader.replace(
+                '#include <map_fragment>',
+                `#ifdef USE_MAP
+                    vec4 sampledDiffuseColor = texture2D(map, (vTile + fract(vMapUv)) * 0.25);
+                    diffuseColor *= sampledDiffuseColor;
+                #endif`
+            );
+        };
+
+        // Water is meshed separately; drawn after the opaque pass without depth writes
+        const waterMaterial = tiledMaterial.clone();
+        waterMaterial.onBeforeCompile = tiledMaterial.onBeforeCompile;
+        waterMaterial.depthWrite = false;
+
+        materialsRef.current = { block: material, tiled: tiledMaterial, water: waterMaterial };
 
         return () => {
             material.dispose();
+            tiledMaterial.dispose();
+            waterMaterial.dispose();
             texture.dispose();
         };
     }, [scene]);
 
-    // 2. Clear Chunks Listener
+    // 2. Regeneration: the next world streams into a staging set while the
+    // current one stays on screen, then replaces it in one step
     useEffect(() => {
-        const unsubscribe = clearChunksFacet.observe((signal) => {
-            if (!signal || !scene) return;
-            console.log('Clearing all chunks');
+        const discardStaging = () => {
+            const staging = stagingRef.current;
+            staging.chunks.forEach(chunk => chunk.dispose(staging.group));
+            staging.chunks.clear();
+            staging.generation = null;
+        };
+
+        const unsubscribeStaging = worldStagingFacet.observe((generation) => {
+            if (generation === null) return;
+            // A newer regen supersedes whatever was staged
+            discardStaging();
+            stagingRef.current.generation = generation;
+        });
+
+        const unsubscribeSwap = worldSwapFacet.observe((generation) => {
+            if (generation === null || !scene) return;
+            const staging = stagingRef.current;
+
             chunksRef.current.forEach(chunk => chunk.dispose(scene));
             chunksRef.current.clear();
+
+            if (generation !== staging.generation) {
+                // Staging was lost (e.g. the UI reloaded mid-regen); resync instead
+                discardStaging();
+                bridge.uiReady();
+                return;
+            }
+
+            console.log(`Swapping in world ${generation}`);
+            staging.chunks.forEach((chunk, key) => {
+                chunk.moveTo(scene);
+                chunksRef.current.set(key, chunk);
+            });
+            staging.chunks.clear();
+            staging.generation = null;
         });
-        return () => unsubscribe();
-    }, [clearChunksFacet, scene]);
 
-    // 3. Chunk Data Listener
+        return () => {
+            unsubscribeStaging();
+            unsubscribeSwap();
+        };
+    }, [worldStagingFacet, worldSwapFacet, scene]);
+
+    // 3. Chunk Data Listeners (live and staged)
     useEffect(() => {
-        const unsubscribe = chunkDataFacet.observe((chunkData) => {
-            if (!chunkData || !scene || !materialRef.current) return;
+        const onChunkData = (staged: boolean) => (chunkData: ChunkData | string | null) => {
+            if (!chunkData) return;
 
+            let data: ChunkData | null = null;
             try {
-                let data: ChunkData;
+                if (!scene || !materialsRef.current) return;
+
                 if (typeof chunkData === 'string') {
-                    data = JSON.parse(chunkData);
+                    // Binary wire format, base64 encoded
+                    data = decodeChunk(chunkData);
                 } else {
                     data = chunkData;
                 }
 
-                const key = `${data.chunkX},${data.chunkZ}`;
-                let chunkMesh = chunksRef.current.get(key);
+                const target: ChunkTarget = staged
+                    ? { chunks: stagingRef.current.chunks, parent: stagingRef.current.group }
+                    : { chunks: chunksRef.current, parent: scene };
+                chunkFor(target, data.chunkX, data.chunkZ).rebuild(target.parent, materialsRef.current.block, data);
+            } catch (error) {
+                console.error('Error processing chunk:', error);
+            } finally {
+                // Only the regeneration sender waits for acks (live sends are
+                // paced per tick). Ack even on failure so it never waits on us.
+                if (staged) bridge.chunkAck(data?.chunkX, data?.chunkZ);
+            }
+        };
+
+        const unsubscribeLive = chunkDataFacet.observe(onChunkData(false));
+        const unsubscribeStaged = stagedChunkDataFacet.observe(onChunkData(true));
+        return () => {
+            unsubscribeLive();
+            unsubscribeStaged();
+        };
+    }, [chunkDataFacet, stagedChunkDataFacet, scene]);
 
-                if (!chunkMesh) {
-                    chunkMesh = new ChunkMesh(data.chunkX, data.chunkZ);
-                    chunksRef.current.set(key, chunkMesh);
-                }
+    // 4. Native Mesh Listeners: geometry meshed on the C++ side (setNativeMeshing)
+    useEffect(() => {
+        const onChunkMesh = (staged: boolean) => (payload: string | null) => {
+            if (!payload) return;
 
-                chunkMesh.rebuild(scene, materialRef.current, data);
+            let chunkX: number | undefined;
+            let chunkZ: number | undefined;
+            try {
+                const materials = materialsRef.current;
+                if (!scene || !materials) return;
+
+                const native = decodeChunkMesh(payload);
+                chunkX = native.chunk.chunkX;
+                chunkZ = native.chunk.chunkZ;
+
+                const target: ChunkTarget = staged
+                    ? { chunks: stagingRef.current.chunks, parent: stagingRef.current.group }
+                    : { chunks: chunksRef.current, parent: scene };
+                chunkFor(target, chunkX, chunkZ).applyNativeMesh(target.parent, materials, native);
             } catch (error) {
-                console.error('Error processing chunk:', error);
+                console.error('Error processing chunk mesh:', error);
+            } finally {
+                // Staged meshes share staged_chunk_data's ack window
+                if (staged) bridge.chunkAck(chunkX, chunkZ);
+            }
+        };
+
+        const unsubscribeLive = chunkMeshFacet.observe(onChunkMesh(false));
+        const unsubscribeStaged = stagedChunkMeshFacet.observe(onChunkMesh(true));
+        return () => {
+            unsubscribeLive();
+            unsubscribeStaged();
+        };
+    }, [chunkMeshFacet, stagedChunkMeshFacet, scene]);
+
+    // 5. Block Delta Listener: authoritative edits as a flat [x, y, z, type, ...] list.
+    // Natively meshed chunks are rebuilt here too until their new chunk_mesh arrives.
+    useEffect(() => {
+        const unsubscribe = blockUpdatesFacet.observe((updates) => {
+            const material = materialsRef.current?.block;
+            if (!updates || !scene || !material) return;
+
+            const first = chunksRef.current.values().next().value as ChunkMesh | undefined;
+            if (!first || !first.chunkData) return;
+            const size = first.chunkData.size;
+
+            const touched = new Set<ChunkMesh>();
+            for (let i = 0; i + 3 < updates.length; i += 4) {
+                const x = updates[i], y = updates[i + 1], z = updates[i + 2], type = updates[i + 3];
+                const chunkX = Math.floor(x / size);
+                const chunkZ = Math.floor(z / size);
+                const chunk = chunksRef.current.get(`${chunkX},${chunkZ}`);
+                if (!chunk || !chunk.chunkData) continue;
+
+                const data = chunk.chunkData;
+                if (y < 0 || y >= data.height) continue;
+                const index = y * size * size + (z - chunkZ * size) * size + (x - chunkX * size);
+                if (data.blocks[index] !== type) {
+                    data.blocks[index] = type;
+                    touched.add(chunk);
+                }
             }
+
+            // One rebuild per chunk, however many of its blocks changed
+            touched.forEach(chunk => chunk.rebuild(scene, material));
         });
         return () => unsubscribe();
-    }, [chunkDataFacet, scene]);
+    }, [blockUpdatesFacet, scene]);
 
-    // 4. Helper to count blocks in all chunks
+    // 6. Helper to count blocks in all chunks
     const countBlocks = (blockType: number): number => {
         let count = 0;
         chunksRef.current.forEach(chunk => {
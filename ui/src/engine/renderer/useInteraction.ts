@@ -1,10 +1,11 @@
 import { useRef, useEffect, useCallback } from 'react';
 import * as THREE from 'three';
-import { ChunkMesh } from '../../game/ChunkMesh';
+import { ChunkMesh, BlockPosition } from '../../game/ChunkMesh';
 import { BlockType, ToolTier, canMineBlock, getDamage, BLOCK_DEFINITIONS, CRAFTING_RECIPES } from '../../game/data/GameDefinitions';
 import { OreHealthSystem } from '../../game/systems/OreHealthSystem';
 import { HitParticleSystem } from '../../game/effects/HitParticles';
 import { spawnDamageNumber } from '../../game/effects/DamageNumberOverlay';
+import { bridge } from '../bridge';
 
 interface InteractionProps {
     scene: THREE.Scene | null;
@@ -15,7 +16,7 @@ interface InteractionProps {
     currentTool: ToolTier;
     isToolBroken: boolean;
     damageMultiplier: number;
-    onResourceCollected?: (type: BlockType, count: number) => void;
+    onResourceCollected?: (type: BlockType, count: number, position: BlockPosition) => void;
     triggerShake?: (intensity: number) => void;
     inventory: Record<BlockType, number>;
 }
@@ -66,9 +67,9 @@ export function useInteraction({
         };
     }, [scene]);
 
-    // Raycast Helper
-    const getHoveredBlock = useCallback((clientX: number, clientY: number) => {
-        if (!camera || !renderer || !containerRef.current) return null;
+    // Camera ray through a point on the screen
+    const getRaycaster = useCallback((clientX: number, clientY: number) => {
+        if (!camera || !renderer) return null;
 
         const rect = renderer.domElement.getBoundingClientRect();
         const mouse = new THREE.Vector2(
@@ -78,9 +79,18 @@ export function useInteraction({
 
         const raycaster = new THREE.Raycaster();
         raycaster.setFromCamera(mouse, camera);
+        return raycaster;
+    }, [camera, renderer]);
+
+    // Raycast Helper (mesh geometry; cheap enough for the per-frame highlight)
+    const getHoveredBlock = useCallback((clientX: number, clientY: number) => {
+        if (!containerRef.current) return null;
+        const raycaster = getRaycaster(clientX, clientY);
+        if (!raycaster) return null;
 
+        // Natively meshed chunks keep water in a separate mesh
         const chunks = Array.from(chunksRef.current.values())
-            .map(c => c.mesh)
+            .flatMap(c => [c.mesh, c.waterMesh])
             .filter(m => m !== null) as THREE.Mesh[];
 
         const intersects = raycaster.intersectObjects(chunks);
@@ -89,7 +99,8 @@ export function useInteraction({
         const intersection = intersects[0];
         const chunk = chunksRef.current.get(
             Array.from(chunksRef.current.keys()).find(key =>
-                chunksRef.current.get(key)!.mesh === intersection.object
+                chunksRef.current.get(key)!.mesh === intersection.object ||
+                chunksRef.current.get(key)!.waterMesh === intersection.object
             )!
         );
 
@@ -118,20 +129,56 @@ export function useInteraction({
         worldPos.z += blockZ + 0.5;
 
         return { chunk, chunkData, blockX, blockY, blockZ, blockIndex, blockType, worldPos, intersectionPoint: intersection.point };
-    }, [camera, renderer, containerRef, chunksRef]);
+    }, [getRaycaster, containerRef, chunksRef]);
+
+    // Block to mine: the game walks the ray through its own copy of the
+    // world, so the block hit is the one it will accept. Falls back to the
+    // mesh raycast without a native side.
+    const pickBlock = useCallback(async (clientX: number, clientY: number) => {
+        const raycaster = getRaycaster(clientX, clientY);
+        if (!raycaster) return null;
+
+        const result = await bridge.raycast(raycaster.ray.origin, raycaster.ray.direction);
+        if (result === null) return getHoveredBlock(clientX, clientY);
+        if (!result.hit) return null;
+
+        // The chunk mesh holding that block
+        const anyChunk = chunksRef.current.values().next().value as ChunkMesh | undefined;
+        if (!anyChunk || !anyChunk.chunkData) return null;
+        const size = anyChunk.chunkData.size;
+        const chunkX = Math.floor(result.x / size);
+        const chunkZ = Math.floor(result.z / size);
+        const chunk = chunksRef.current.get(`${chunkX},${chunkZ}`);
+        if (!chunk || !chunk.chunkData) return null;
 
-    // Mine Logic
-    const handleMine = useCallback((e: MouseEvent) => {
-        if (!oreHealthRef.current || !particleSystemRef.current || !scene || !containerRef.current) return;
+        const chunkData = chunk.chunkData;
+        const blockX = result.x - chunkX * size;
+        const blockY = result.y;
+        const blockZ = result.z - chunkZ * size;
+        const blockIndex = blockY * size * size + blockZ * size + blockX;
+        const worldPos = new THREE.Vector3(result.x + 0.5, result.y + 0.5, result.z + 0.5);
+        const intersectionPoint = raycaster.ray.at(result.distance, new THREE.Vector3());
 
-        const hit = getHoveredBlock(e.clientX, e.clientY);
+        return { chunk, chunkData, blockX, blockY, blockZ, blockIndex, blockType: result.type as BlockType, worldPos, intersectionPoint };
+    }, [getRaycaster, getHoveredBlock, chunksRef]);
+
+    // Mine Logic
+    const handleMine = useCallback(async (e: MouseEvent) => {
+        const hit = await pickBlock(e.clientX, e.clientY);
         if (!hit) return;
+        if (!oreHealthRef.current || !particleSystemRef.current || !scene || !containerRef.current) return;
 
         const { chunk, chunkData, blockX, blockY, blockZ, blockIndex, blockType, worldPos } = hit;
         const { currentTool, isToolBroken, damageMultiplier, onResourceCollected, triggerShake } = propsRef.current;
 
         if (blockType === BlockType.Air || blockType === BlockType.Bedrock) return;
 
+        const blockPos: BlockPosition = {
+            x: chunkData.chunkX * chunkData.size + blockX,
+            y: blockY,
+            z: chunkData.chunkZ * chunkData.size + blockZ
+        };
+
         // UNBREAKABLE FEEDBACK
         if (!canMineBlock(blockType, currentTool)) {
             // Trigger feedback
@@ -139,7 +186,7 @@ export function useInteraction({
             if (camera) spawnDamageNumber(worldPos, 0, camera, containerRef.current, "#ff8800"); // Orange "0"
 
             // Still damage the tool (count 0 means no resource given, but tool was used)
-            onResourceCollected?.(blockType, 0);
+            onResourceCollected?.(blockType, 0, blockPos);
             return;
         }
 
@@ -191,13 +238,13 @@ export function useInteraction({
             // We need theaterial... how to access it? 
             // ChunkMesh needs material for rebuild.
             // We don't have access to material here easily unless passed.
-            // However, ChunkMesh.mesh.material exists!
-            if (chunk.mesh && chunk.mesh.material) {
-                chunk.rebuild(scene, chunk.mesh.material as THREE.Material, chunkData);
+            // However, ChunkMesh keeps the one it was last built with!
+            if (chunk.blockMaterial) {
+                chunk.rebuild(scene, chunk.blockMaterial, chunkData);
             }
 
             if (outlineBoxRef.current) outlineBoxRef.current.visible = false;
-            onResourceCollected?.(blockType, 1);
+            onResourceCollected?.(blockType, 1, blockPos);
 
             // SPLASH DAMAGE: Diamond pickaxe (non-broken) deals splash damage to adjacent blocks
             if (currentTool === ToolTier.DIAMOND_PICK && !isToolBroken) {
@@ -267,10 +314,14 @@ export function useInteraction({
                             // If splash broke the block, remove it
                             if (splashResult.broke) {
                                 targetChunkData.blocks[targetIndex] = BlockType.Air;
-                                if (targetChunk.mesh && targetChunk.mesh.material) {
-                                    targetChunk.rebuild(scene, targetChunk.mesh.material as THREE.Material, targetChunkData);
+                                if (targetChunk.blockMaterial) {
+                                    targetChunk.rebuild(scene, targetChunk.blockMaterial, targetChunkData);
                                 }
-                                onResourceCollected?.(targetBlockType, 1);
+                                onResourceCollected?.(targetBlockType, 1, {
+                                    x: targetChunkData.chunkX * targetChunkData.size + targetX,
+                                    y: targetY,
+                                    z: targetChunkData.chunkZ * targetChunkData.size + targetZ
+                                });
                             }
                         }
                     }
@@ -298,7 +349,7 @@ export function useInteraction({
             }
         }
 
-    }, [getHoveredBlock, scene, camera, containerRef]); // propsRef stable
+    }, [pickBlock, scene, camera, containerRef]); // propsRef stable
 
     // Mouse Move Tracker
     useEffect(() => {
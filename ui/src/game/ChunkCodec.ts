@@ -0,0 +1,104 @@
+import { ChunkData } from './ChunkMesh';
+
+// Binary chunk wire format, mirrors src/world/ChunkCodec.h
+//
+//   offset  size  field
+//   0       4     magic "OFCK"
+//   4       1     version
+//   5       1     flags (reserved)
+//   6       2     size   (uint16)
+//   8       2     height (uint16)
+//   10      2     reserved
+//   12      4     chunkX (int32)
+//   16      4     chunkZ (int32)
+//   20      N     block IDs (uint8)
+const CHUNK_WIRE_VERSION = 1;
+const CHUNK_WIRE_HEADER_SIZE = 20;
+
+// Native mesh payload (chunk_mesh), same header up to offset 20, then
+//
+//   20      4     opaque quad count (uint32)
+//   24      4     water quad count  (uint32)
+//   28      N     block IDs (uint8)
+//   ...           opaque vertices, then water vertices, 4 per quad
+const CHUNK_MESH_WIRE_VERSION = 1;
+const CHUNK_MESH_WIRE_HEADER_SIZE = 28;
+
+// Vertex record: x, y, z, face, u, v, tile (gridX | gridY << 4), ao (0-3)
+export const MESH_VERTEX_SIZE = 8;
+
+export interface NativeChunkMesh {
+    chunk: ChunkData;
+    opaque: Uint8Array; // Vertex records
+    water: Uint8Array;
+}
+
+export function base64ToBytes(payload: string): Uint8Array {
+    const binary = atob(payload);
+    const bytes = new Uint8Array(binary.length);
+    for (let i = 0; i < binary.length; i++) {
+        bytes[i] = binary.charCodeAt(i);
+    }
+    return bytes;
+}
+
+// Validates magic ("OFC" + kind) and version, returns a view over the header
+function readHeader(bytes: Uint8Array, kind: number, version: number, headerSize: number): DataView {
+    if (bytes.length < headerSize ||
+        bytes[0] !== 0x4F || bytes[1] !== 0x46 || bytes[2] !== 0x43 || bytes[3] !== kind) {
+        throw new Error('Invalid chunk payload');
+    }
+
+    const view = new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    const payloadVersion = view.getUint8(4);
+    if (payloadVersion !== version) {
+        throw new Error(`Unsupported chunk payload version ${payloadVersion}`);
+    }
+    return view;
+}
+
+function readChunk(bytes: Uint8Array, view: DataView, blocksOffset: number): ChunkData {
+    const size = view.getUint16(6, true);
+    const height = view.getUint16(8, true);
+    const chunkX = view.getInt32(12, true);
+    const chunkZ = view.getInt32(16, true);
+
+    const blockCount = size * size * height;
+    if (bytes.length < blocksOffset + blockCount) {
+        throw new Error('Truncated chunk payload');
+    }
+
+    return {
+        chunkX,
+        chunkZ,
+        size,
+        height,
+        blocks: bytes.subarray(blocksOffset, blocksOffset + blockCount),
+    };
+}
+
+export function decodeChunk(payload: string): ChunkData {
+    const bytes = base64ToBytes(payload);
+    const view = readHeader(bytes, 0x4B, CHUNK_WIRE_VERSION, CHUNK_WIRE_HEADER_SIZE);
+    return readChunk(bytes, view, CHUNK_WIRE_HEADER_SIZE);
+}
+
+export function decodeChunkMesh(payload: string): NativeChunkMesh {
+    const bytes = base64ToBytes(payload);
+    const view = readHeader(bytes, 0x4D, CHUNK_MESH_WIRE_VERSION, CHUNK_MESH_WIRE_HEADER_SIZE);
+    const chunk = readChunk(bytes, view, CHUNK_MESH_WIRE_HEADER_SIZE);
+
+    const opaqueBytes = view.getUint32(20, true) * 4 * MESH_VERTEX_SIZE;
+    const waterBytes = view.getUint32(24, true) * 4 * MESH_VERTEX_SIZE;
+    const opaqueStart = CHUNK_MESH_WIRE_HEADER_SIZE + chunk.blocks.length;
+    const waterStart = opaqueStart + opaqueBytes;
+    if (bytes.length < waterStart + waterBytes) {
+        throw new Error('Truncated chunk mesh payload');
+    }
+
+    return {
+        chunk,
+        opaque: bytes.subarray(opaqueStart, waterStart),
+        water: bytes.subarray(waterStart, waterStart + waterBytes),
+    };
+}
@@ -1,25 +1,92 @@
 import * as THREE from 'three';
+import { MESH_VERTEX_SIZE } from './ChunkCodec';
+import type { NativeChunkMesh } from './ChunkCodec';
 
 export interface ChunkData {
     chunkX: number;
     chunkZ: number;
-    blocks: number[];
+    blocks: Uint8Array; // Block IDs, index = y * size * size + z * size + x
     size: number;
     height: number;
 }
 
+// World-space block coordinates (as used by the C++ World)
+export interface BlockPosition {
+    x: number;
+    y: number;
+    z: number;
+}
+
+// Materials shared by all chunks
+export interface ChunkMaterials {
+    block: THREE.Material; // Chunks meshed here (atlas UVs baked into the geometry)
+    tiled: THREE.Material; // Native meshes: atlas tile per vertex, UVs repeat across merged quads
+    water: THREE.Material; // Native meshes: transparent water pass
+}
+
+// Expands native vertex records (see ChunkCodec.ts) into geometry for the tiled materials
+function buildNativeGeometry(records: Uint8Array): THREE.BufferGeometry {
+    const vertexCount = records.length / MESH_VERTEX_SIZE;
+    const positions = new Float32Array(vertexCount * 3);
+    const uvs = new Float32Array(vertexCount * 2);
+    const tiles = new Float32Array(vertexCount * 2);
+    const aoValues = new Float32Array(vertexCount);
+    const localUVs = new Float32Array(vertexCount * 2);
+    const corners = [0, 0, 1, 0, 1, 1, 0, 1]; // BL, BR, TR, TL (wireframe shader)
+
+    for (let i = 0; i < vertexCount; i++) {
+        const r = i * MESH_VERTEX_SIZE;
+        positions[i * 3] = records[r];
+        positions[i * 3 + 1] = records[r + 1];
+        positions[i * 3 + 2] = records[r + 2];
+        uvs[i * 2] = records[r + 4];
+        uvs[i * 2 + 1] = records[r + 5];
+        tiles[i * 2] = records[r + 6] & 15;
+        tiles[i * 2 + 1] = records[r + 6] >> 4;
+        aoValues[i] = 1.0 - records[r + 7] * 0.23;
+        localUVs[i * 2] = corners[(i % 4) * 2];
+        localUVs[i * 2 + 1] = corners[(i % 4) * 2 + 1];
+    }
+
+    // Two triangles per quad, same winding as rebuild()
+    const quadCount = vertexCount / 4;
+    const indices = vertexCount > 65535 ? new Uint32Array(quadCount * 6) : new Uint16Array(quadCount * 6);
+    for (let q = 0; q < quadCount; q++) {
+        const v = q * 4;
+        const o = q * 6;
+        indices[o] = v;
+        indices[o + 1] = v + 1;
+        indices[o + 2] = v + 2;
+        indices[o + 3] = v;
+        indices[o + 4] = v + 2;
+        indices[o + 5] = v + 3;
+    }
+
+    const geometry = new THREE.BufferGeometry();
+    geometry.setAttribute('position', new THREE.BufferAttribute(positions, 3));
+    geometry.setAttribute('uv', new THREE.BufferAttribute(uvs, 2));
+    geometry.setAttribute('tile', new THREE.BufferAttribute(tiles, 2));
+    geometry.setAttribute('ao', new THREE.BufferAttribute(aoValues, 1));
+    geometry.setAttribute('localUV', new THREE.BufferAttribute(localUVs, 2));
+    geometry.setIndex(new THREE.BufferAttribute(indices, 1));
+    geometry.computeVertexNormals();
+    return geometry;
+}
+
 export class ChunkMesh {
     mesh: THREE.Mesh | null = null;
+    waterMesh: THREE.Mesh | null = null; // Native meshes only
     chunkX: number;
     chunkZ: number;
     chunkData!: ChunkData; // Definite assignment assertion
+    blockMaterial: THREE.Material | null = null; // For local rebuilds after edits
 
     constructor(chunkX: number, chunkZ: number) {
         this.chunkX = chunkX;
         this.chunkZ = chunkZ;
     }
 
-    rebuild(scene: THREE.Scene, material: THREE.Material, chunkData?: ChunkData) {
+    rebuild(scene: THREE.Object3D, material: THREE.Material, chunkData?: ChunkData) {
         if (chunkData) {
             this.chunkData = chunkData;
         } else if (!this.chunkData) {
@@ -28,14 +95,10 @@ export class ChunkMesh {
         }
 
         const data = this.chunkData;
+        this.blockMaterial = material;
 
         // Remove old mesh if it exists
-        if (this.mesh) {
-            scene.remove(this.mesh);
-            this.mesh.geometry.dispose();
-            // Material is shared, do not dispose it
-            this.mesh = null;
-        }
+        this.clearMeshes(scene);
 
         const geometry = new THREE.BufferGeometry();
         const vertices: number[] = [];
@@ -349,12 +412,50 @@ export class ChunkMesh {
         scene.add(this.mesh);
     }
 
-    dispose(scene: THREE.Scene) {
-        if (this.mesh) {
-            scene.remove(this.mesh);
-            this.mesh.geometry.dispose();
-            // Material is shared, do not dispose it
-            this.mesh = null;
+    // Replace the geometry with a mesh built by the C++ side (chunk_mesh)
+    applyNativeMesh(scene: THREE.Object3D, materials: ChunkMaterials, native: NativeChunkMesh) {
+        // Own copy of the blocks so the payload (vertex data) can be collected
+        this.chunkData = { ...native.chunk, blocks: native.chunk.blocks.slice() };
+        this.blockMaterial = materials.block;
+        this.clearMeshes(scene);
+
+        const { chunkX, chunkZ, size } = native.chunk;
+
+        if (native.opaque.length > 0) {
+            this.mesh = new THREE.Mesh(buildNativeGeometry(native.opaque), materials.tiled);
+            this.mesh.castShadow = true;
+            this.mesh.receiveShadow = true;
+            this.mesh.position.set(chunkX * size, 0, chunkZ * size);
+            scene.add(this.mesh);
+        }
+
+        if (native.water.length > 0) {
+            this.waterMesh = new THREE.Mesh(buildNativeGeometry(native.water), materials.water);
+            this.waterMesh.receiveShadow = true;
+            this.waterMesh.position.set(chunkX * size, 0, chunkZ * size);
+            scene.add(this.waterMesh);
+        }
+    }
+
+    dispose(scene: THREE.Object3D) {
+        this.clearMeshes(scene);
+    }
+
+    // Reparent the meshes, e.g. from a regen's off-screen staging group to the scene
+    moveTo(parent: THREE.Object3D) {
+        if (this.mesh) parent.add(this.mesh);
+        if (this.waterMesh) parent.add(this.waterMesh);
+    }
+
+    private clearMeshes(scene: THREE.Object3D) {
+        for (const mesh of [this.mesh, this.waterMesh]) {
+            if (mesh) {
+                scene.remove(mesh);
+                mesh.geometry.dispose();
+                // Material is shared, do not dispose it
+            }
         }
+        this.mesh = null;
+        this.waterMesh = null;
     }
 }
@@ -5,6 +5,7 @@ import { useInteraction } from '../engine/renderer/useInteraction';
 import { useCameraControls } from '../engine/renderer/useCameraControls';
 import { DamageNumberOverlay } from './effects/DamageNumberOverlay';
 import { BlockType, ToolTier } from './data/GameDefinitions';
+import { BlockPosition } from './ChunkMesh';
 
 interface VoxelRendererProps {
     autoRotate?: boolean;
@@ -12,7 +13,7 @@ interface VoxelRendererProps {
     currentTool?: ToolTier;
     isToolBroken?: boolean;
     damageMultiplier?: number;
-    onResourceCollected?: (type: BlockType, count: number) => void;
+    onResourceCollected?: (type: BlockType, count: number, position: BlockPosition) => void;
     onWorldUpdate?: (stats: Record<BlockType, number>) => void;
     externalShakeTrigger?: number; // Timestamp to trigger shake
     cameraResetTrigger?: number; // Timestamp to trigger camera reset
@@ -1,3 +1,4 @@
+import { facetManager } from '../../engine/bridge';
 import { remoteFacet } from '../../engine/hooks';
 import { BlockType } from './GameDefinitions';
 
@@ -26,5 +27,9 @@ export const Facets = {
     WorldSeed: remoteFacet('world_seed', "12345"),
     IsGenerating: remoteFacet('is_generating', false),
     CountWater: remoteFacet('count_water', false),
+    NativeMeshing: remoteFacet('native_meshing', false),
     ShowToast: remoteFacet('show_toast', ''),
 };
+
+// Per tick the game sends only the inventory counts that changed
+facetManager.mergeInto('inventory_patch', 'inventory');
@@ -27,12 +27,13 @@ export const RegenOverlay: React.FC = () => {
 
     if (!generating) return null;
 
+    // The current world stays playable while the next one builds, so this
+    // only marks progress instead of covering the scene
     return (
         <div style={{
-            position: 'absolute', top: 0, left: 0, right: 0, bottom: 0,
-            backgroundColor: Colors.Black,
-            display: 'flex', alignItems: 'center', justifyContent: 'center',
-            zIndex: 100, pointerEvents: 'auto'
+            position: 'absolute', top: '20px', left: 0, right: 0,
+            display: 'flex', justifyContent: 'center',
+            zIndex: 100, pointerEvents: 'none'
         }}>
             <Panel style={{ padding: '30px', textAlign: 'center' }}>
                 <h2 style={{